@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cmath>
 using std::cout;
 using std::endl;
 #include "time.h" //include it here too
@@ -22,14 +23,14 @@ bool after (const Time& time1, const Time& time2) {
 void increment (Time& time, double secs) {
   time.second += secs;
 
-  if (time.second >= 60.0) {
-    time.second -= 60.0;
-    time.minute += 1;
-  }
-  if (time.minute >= 60) {
-    time.minute -= 60;
-    time.hour += 1;
-  }
+  //carry whole minutes and hours with one divide each, however big secs is
+  int minutes = (int) floor (time.second / 60.0);
+  time.second -= minutes * 60.0;
+  time.minute += minutes;
+
+  int hours = time.minute / 60;
+  time.minute %= 60;
+  time.hour += hours;
 }
 
 double convertToSeconds (const Time& time) {
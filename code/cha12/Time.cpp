@@ -1,62 +1,41 @@
 #include <iostream>
+#include <cmath>
 using namespace std;
 #include "Time.h"
 
-Time::Time (int h, int m, double s)
+int64_t secondsToNanos (double secs)
 {
-  hour = h;  minute = m;  second = s;
+  return llround (secs * NANOS_PER_SECOND);
 }
 
-Time::Time (double secs)
+Time::Time (int h, int m, double s)
 {
-  hour = (int) (secs / 3600.0);
-  secs -= hour * 3600.0;
-  minute = (int) (secs / 60.0);
-  secs -= minute * 60.0;
-  second = secs;
+  nanos = h * NANOS_PER_HOUR + m * NANOS_PER_MINUTE + secondsToNanos (s);
 }
 
-void Time::increment (double secs)
+Time::Time (double secs)
 {
-  second += secs;
-
-  while (second >= 60.0) {
-    second -= 60.0;
-    minute += 1;
-  }
-  while (minute >= 60) {
-    minute -= 60;
-    hour += 1;
-  }
+  nanos = secondsToNanos (secs);
 }
 
-void Time::print () const
+Time Time::fromNanos (int64_t n)
 {
-  cout << hour << ":" << minute << ":" << second << endl;
+  Time time (0.0);
+  time.nanos = n;
+  return time;
 }
 
-bool Time::after (const Time& time2) const
+void Time::increment (double secs)
 {
-  if (hour > time2.hour) return true;
-  if (hour < time2.hour) return false;
-
-  if (minute > time2.minute) return true;
-  if (minute < time2.minute) return false;
-
-  if (second > time2.second) return true;
-  return false;
+  nanos += secondsToNanos (secs);
 }
 
-Time Time::add (const Time& t2) const
+void Time::print () const
 {
-  double seconds = convertToSeconds() + t2.convertToSeconds();
-  Time time (seconds);
-  return time;
+  cout << hour () << ":" << minute () << ":" << second () << endl;
 }
 
 double Time::convertToSeconds () const
 {
-  int minutes = hour * 60 + minute;
-  double seconds = minutes * 60 + second;
-  return seconds;
+  return (double) nanos / NANOS_PER_SECOND;
 }
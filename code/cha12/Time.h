@@ -1,18 +1,43 @@
+#ifndef TIME_H
+#define TIME_H
+#include <stdint.h>
+
+// A time is stored as one exact count of nanoseconds since midnight,
+// so adding and comparing times is integer arithmetic that never
+// drifts.  Hours, minutes and seconds are worked out when they are
+// asked for.  Times are not reduced modulo one day: adding 20 hours to
+// 9:00 gives 29:00.
+const int64_t NANOS_PER_SECOND = 1000000000LL;
+const int64_t NANOS_PER_MINUTE = 60 * NANOS_PER_SECOND;
+const int64_t NANOS_PER_HOUR = 60 * NANOS_PER_MINUTE;
+
 struct Time {
   // instance variables
-  int hour, minute;
-  double second;
+  int64_t nanos;
 
   // constructors
   Time (int hour, int min, double secs);
   Time (double secs);
+  static Time fromNanos (int64_t nanos);
+
+  // accessors
+  int hour () const { return (int) (nanos / NANOS_PER_HOUR); }
+  int minute () const { return (int) (nanos / NANOS_PER_MINUTE % 60); }
+  double second () const {
+    return (double) (nanos % NANOS_PER_MINUTE) / NANOS_PER_SECOND;
+  }
 
   // modifiers
   void increment (double secs);
+  void incrementNanos (int64_t n) { nanos += n; }
 
   // functions
   void print () const;
-  bool after (const Time& time2) const;
-  Time add (const Time& t2) const;
+  bool after (const Time& time2) const { return nanos > time2.nanos; }
+  Time add (const Time& t2) const { return fromNanos (nanos + t2.nanos); }
   double convertToSeconds () const;
 };
+
+// the nearest whole number of nanoseconds to secs
+int64_t secondsToNanos (double secs);
+#endif
@@ -0,0 +1,117 @@
+#include <cstring>
+#include "TimeFormat.h"
+
+// byte masks for "HH:MM:SS" and ".fff", in memory order
+const uint64_t HMS_DIGITS = 0xFFFF00FFFF00FFFFULL;
+const uint64_t HMS_SEPARATORS = 0x00003A00003A0000ULL;    // the colons
+const uint32_t FRAC_DIGITS = 0xFFFFFF00u;
+const uint32_t FRAC_SEPARATOR = 0x0000002Eu;              // the '.'
+
+// true if every byte selected by mask is an ASCII digit
+static inline bool allDigits (uint64_t x, uint64_t mask)
+{
+  const uint64_t lowNibbles = 0x0F0F0F0F0F0F0F0FULL & mask;
+  const uint64_t threes = 0x3030303030303030ULL & mask;
+  // '0'..'9' are 0x30..0x39: the high nibble must be 3, and adding 6
+  // must not carry out of the low nibble
+  bool high = (x & ~lowNibbles & mask) == threes;
+  bool low = (((x & lowNibbles) + (0x0606060606060606ULL & mask))
+              & 0xF0F0F0F0F0F0F0F0ULL & mask) == 0;
+  return high && low;
+}
+
+bool parseTime (const char* text, Time& time)
+{
+  uint64_t hms;
+  uint32_t frac;
+  memcpy (&hms, text, 8);
+  memcpy (&frac, text + 8, 4);
+
+  if ((hms & ~HMS_DIGITS) != HMS_SEPARATORS) return false;
+  if ((frac & ~FRAC_DIGITS) != FRAC_SEPARATOR) return false;
+  if (!allDigits (hms, HMS_DIGITS)) return false;
+  if (!allDigits (frac, FRAC_DIGITS)) return false;
+
+  // byte i becomes 10 * digit i + digit i+1; no byte goes over 99, so
+  // nothing carries into its neighbour
+  uint64_t d = (hms & 0x0F0F0F0F0F0F0F0FULL & HMS_DIGITS);
+  uint64_t pairs = d * 10 + (d >> 8);
+  int hour = (int) (pairs & 0xFF);
+  int minute = (int) ((pairs >> 24) & 0xFF);
+  int second = (int) ((pairs >> 48) & 0xFF);
+  if (minute >= 60 || second >= 60) return false;
+
+  uint32_t f = frac & 0x0F0F0F0F;
+  int millis = ((f >> 8) & 0xF) * 100 + ((f >> 16) & 0xF) * 10 + (f >> 24);
+
+  time = Time::fromNanos (hour * NANOS_PER_HOUR + minute * NANOS_PER_MINUTE
+                          + second * NANOS_PER_SECOND + millis * 1000000LL);
+  return true;
+}
+
+void formatTime (const Time& time, char* out)
+{
+  // the fields only have room for 00:00:00.000 to 99:59:59.999
+  const int64_t latest = 100 * NANOS_PER_HOUR - 1;
+  int64_t n = time.nanos;
+  n = n < 0 ? 0 : n;
+  n = n > latest ? latest : n;
+  uint64_t hour = n / NANOS_PER_HOUR;
+  uint64_t minute = n / NANOS_PER_MINUTE % 60;
+  uint64_t second = n / NANOS_PER_SECOND % 60;
+  uint32_t millis = (uint32_t) (n / 1000000 % 1000);
+
+  // hours, minutes and seconds in three 16-bit lanes; v * 103 >> 10 is
+  // v / 10 for v below 100, and the mask drops what the shift brings
+  // down from the lane above
+  uint64_t lanes = hour | (minute << 16) | (second << 32);
+  uint64_t tens = ((lanes * 103) >> 10) & 0x0000000F000F000FULL;
+  uint64_t ones = lanes - tens * 10;
+  uint64_t digits = tens | (ones << 8);     // each lane is now tens, ones
+
+  // spread the lanes out to make room for the colons
+  uint64_t hms = (digits & 0xFFFF)
+               | ((digits & 0xFFFF0000ULL) << 8)
+               | ((digits & 0xFFFF00000000ULL) << 16);
+  hms |= 0x3030003030003030ULL | HMS_SEPARATORS;
+
+  uint32_t hundreds = (millis * 41) >> 12;  // millis / 100 below 1000
+  uint32_t rest = millis - hundreds * 100;
+  uint32_t tensMs = (rest * 103) >> 10;
+  uint32_t onesMs = rest - tensMs * 10;
+  uint32_t frac = FRAC_SEPARATOR | (hundreds << 8) | (tensMs << 16)
+                | (onesMs << 24) | 0x30303000u;
+
+  memcpy (out, &hms, 8);
+  memcpy (out + 8, &frac, 4);
+}
+
+long parseTimes (const char* buffer, size_t size, vector<Time>& times)
+{
+  long bad = 0;
+  const char* p = buffer;
+  const char* end = buffer + size;
+  while (p < end) {
+    const char* eol = (const char*) memchr (p, '\n', end - p);
+    if (eol == NULL) eol = end;
+    Time time (0.0);
+    if (eol - p >= TIME_TEXT_SIZE && parseTime (p, time)) {
+      times.push_back (time);
+    } else {
+      bad++;
+    }
+    p = eol + 1;
+  }
+  return bad;
+}
+
+size_t formatTimes (const Time* times, long n, char* out)
+{
+  char* p = out;
+  for (long i = 0; i < n; i++) {
+    formatTime (times[i], p);
+    p[TIME_TEXT_SIZE] = '\n';
+    p += TIME_TEXT_SIZE + 1;
+  }
+  return p - out;
+}
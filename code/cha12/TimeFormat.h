@@ -0,0 +1,35 @@
+#ifndef TIMEFORMAT_H
+#define TIMEFORMAT_H
+#include <stddef.h>
+#include <vector>
+#include "Time.h"
+using namespace std;
+
+// Reading and writing times as fixed-width "HH:MM:SS.fff" text, the
+// way they appear at the start of log lines.  Because every field is
+// at a known offset, the whole timestamp is loaded as two machine
+// words and all the digits are checked and converted at once with
+// ordinary integer arithmetic on the packed bytes ("SIMD within a
+// register"), instead of one character at a time.  This assumes a
+// little-endian machine.
+const int TIME_TEXT_SIZE = 12;
+
+// Parses the TIME_TEXT_SIZE characters at text.  Returns false, and
+// leaves time alone, if they are not two-digit hours, minutes below
+// 60, seconds below 60 and three digits of milliseconds.
+bool parseTime (const char* text, Time& time);
+
+// Writes TIME_TEXT_SIZE characters (no terminator) to out.  Anything
+// below a millisecond is dropped.  Times before 0 are written as
+// 00:00:00.000 and times from 100 hours up as 99:59:59.999.
+void formatTime (const Time& time, char* out);
+
+// Parses the timestamp at the start of every line in buffer and
+// appends them to times.  Returns the number of lines that did not
+// start with a valid timestamp; those are skipped.
+long parseTimes (const char* buffer, size_t size, vector<Time>& times);
+
+// Writes one "HH:MM:SS.fff\n" line per time and returns the number of
+// bytes written, which is n * (TIME_TEXT_SIZE + 1).
+size_t formatTimes (const Time* times, long n, char* out);
+#endif
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <thread>
+#include "TimeIndex.h"
+
+void parallelSort (vector<int64_t>& keys, int numThreads)
+{
+  long n = keys.size();
+  int parts = 1;
+  while (parts * 2 <= numThreads && n / (parts * 2) >= 65536) parts *= 2;
+  if (parts == 1) {
+    sort (keys.begin(), keys.end());
+    return;
+  }
+
+  // sort parts separately, then merge neighbours in rounds, each round
+  // going back and forth between keys and the buffer
+  vector<long> bounds (parts + 1);
+  for (int p = 0; p <= parts; p++) bounds[p] = n * p / parts;
+  vector<thread> workers;
+  for (int p = 0; p < parts; p++) {
+    workers.push_back (thread ([&, p] () {
+      sort (keys.begin() + bounds[p], keys.begin() + bounds[p+1]);
+    }));
+  }
+  for (int p = 0; p < parts; p++) workers[p].join ();
+
+  vector<int64_t> buffer (n);
+  int64_t* from = keys.data();
+  int64_t* to = buffer.data();
+  for (int width = 1; width < parts; width *= 2) {
+    workers.clear ();
+    for (int p = 0; p < parts; p += 2 * width) {
+      long lo = bounds[p], mid = bounds[p + width];
+      long hi = bounds[min (p + 2 * width, parts)];
+      workers.push_back (thread ([=] () {
+        merge (from + lo, from + mid, from + mid, from + hi, to + lo);
+      }));
+    }
+    for (int i = 0; i < workers.size(); i++) workers[i].join ();
+    swap (from, to);
+  }
+  if (from != keys.data()) keys.swap (buffer);
+}
+
+TimeIndex::TimeIndex (const int64_t* times, long n, int numThreads)
+  : keys (times, times + n)
+{
+  build (numThreads);
+}
+
+TimeIndex::TimeIndex (const vector<Time>& times, int numThreads)
+{
+  keys.resize (times.size());
+  for (long i = 0; i < times.size(); i++) keys[i] = times[i].nanos;
+  build (numThreads);
+}
+
+void TimeIndex::build (int numThreads)
+{
+  parallelSort (keys, numThreads);
+  top.clear ();
+  for (long i = 0; i < keys.size(); i += SAMPLE) top.push_back (keys[i]);
+}
+
+// the number of keys in [base, base + n) that are less than key, or
+// not greater than key if inclusive is set
+static inline long bisect (const int64_t* base, long n, int64_t key,
+                           bool inclusive)
+{
+  if (n == 0) return 0;
+  const int64_t* p = base;
+  while (n > 1) {
+    long half = n / 2;
+    bool right = inclusive ? p[half] <= key : p[half] < key;
+    p = right ? p + half : p;
+    n -= half;
+  }
+  return (p - base) + (inclusive ? *p <= key : *p < key);
+}
+
+static inline long search (const TimeIndex& index, int64_t key,
+                           bool inclusive)
+{
+  const int S = TimeIndex::SAMPLE;
+  long numBlocks = index.top.size();
+  // the last block whose first key comes before the answer
+  long block = bisect (index.top.data(), numBlocks, key, inclusive) - 1;
+  if (block < 0) return 0;
+  long first = block * S;
+  long len = min ((long) S, (long) index.keys.size() - first);
+  return first + bisect (index.keys.data() + first, len, key, inclusive);
+}
+
+long TimeIndex::lowerBound (int64_t key) const
+{
+  return search (*this, key, false);
+}
+
+long TimeIndex::upperBound (int64_t key) const
+{
+  return search (*this, key, true);
+}
+
+TimeSpan TimeIndex::range (const Time& from, const Time& to) const
+{
+  TimeSpan span;
+  long lo = lowerBound (from.nanos);
+  long hi = (to.nanos < from.nanos) ? lo : upperBound (to.nanos);
+  span.first = keys.data() + lo;
+  span.last = keys.data() + hi;
+  return span;
+}
+
+void TimeIndex::ranges (const Time* from, const Time* to, long m,
+                        TimeSpan* out) const
+{
+  const int BATCH = 8;
+  const int S = SAMPLE;
+  const long numBlocks = top.size();
+  const long n = keys.size();
+  // 2 * BATCH searches in flight: the lower and upper end of each range
+  int64_t key[2 * BATCH];
+  const int64_t* p[2 * BATCH];
+  long result[2 * BATCH];
+
+  for (long q = 0; q < m; q += BATCH) {
+    int count = (int) min ((long) BATCH, m - q);
+    int numSearches = 2 * count;
+    for (int i = 0; i < count; i++) {
+      key[2*i] = from[q+i].nanos;
+      key[2*i+1] = to[q+i].nanos;
+    }
+
+    // the top array, in lockstep; odd searches are inclusive
+    for (int s = 0; s < numSearches; s++) p[s] = top.data();
+    long len = numBlocks;
+    while (len > 1) {
+      long half = len / 2;
+      for (int s = 0; s < numSearches; s++) {
+        bool right = (s & 1) ? p[s][half] <= key[s] : p[s][half] < key[s];
+        p[s] = right ? p[s] + half : p[s];
+        __builtin_prefetch (p[s] + (len - half) / 2);
+      }
+      len -= half;
+    }
+    for (int s = 0; s < numSearches; s++) {
+      long block = (p[s] - top.data()) - 1;
+      if (numBlocks > 0) {
+        block += (s & 1) ? *p[s] <= key[s] : *p[s] < key[s];
+      }
+      result[s] = (block < 0) ? -1 : block * S;
+      if (block >= 0) __builtin_prefetch (keys.data() + block * S + S / 2);
+    }
+
+    // then one block each
+    for (int s = 0; s < numSearches; s++) {
+      if (result[s] < 0) {
+        result[s] = 0;
+        continue;
+      }
+      long first = result[s];
+      long blockLen = min ((long) S, n - first);
+      result[s] = first + bisect (keys.data() + first, blockLen, key[s],
+                                  s & 1);
+    }
+
+    for (int i = 0; i < count; i++) {
+      long lo = result[2*i];
+      long hi = (key[2*i+1] < key[2*i]) ? lo : result[2*i+1];
+      out[q+i].first = keys.data() + lo;
+      out[q+i].last = keys.data() + hi;
+    }
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+#include <stdint.h>
+#include <vector>
+#include "Time.h"
+using namespace std;
+
+// A run of keys in a TimeIndex: all the times in a range are stored
+// next to each other, so a query result is just two pointers.
+struct TimeSpan {
+  const int64_t* first;
+  const int64_t* last;     // one past the end
+
+  long size () const { return last - first; }
+  Time operator[] (long i) const { return Time::fromNanos (first[i]); }
+};
+
+// An immutable sorted copy of a set of times (their nanosecond counts),
+// for answering "which events fall between t1 and t2".  Every
+// SAMPLE-th key is also copied into a small top-level array.  A search
+// first bisects the top array, which is small enough to stay in cache,
+// and then one block of SAMPLE keys in the big array, so a lookup
+// touches only a few cache lines of the main data.  Both bisections
+// are branchless.
+struct TimeIndex {
+  static const int SAMPLE = 64;
+
+  vector<int64_t> keys;
+  vector<int64_t> top;      // top[b] = keys[b * SAMPLE]
+
+  // sorts the times with numThreads threads
+  TimeIndex (const int64_t* times, long n, int numThreads = 1);
+  TimeIndex (const vector<Time>& times, int numThreads = 1);
+
+  long size () const { return keys.size(); }
+
+  // index of the first key >= key, or of the first key > key
+  long lowerBound (int64_t key) const;
+  long upperBound (int64_t key) const;
+
+  // the times t with from <= t <= to
+  TimeSpan range (const Time& from, const Time& to) const;
+
+  // m ranges at once: the searches walk down in lockstep so their
+  // cache misses overlap
+  void ranges (const Time* from, const Time* to, long m, TimeSpan* out) const;
+
+  void build (int numThreads);
+};
+
+// sorts keys in place using numThreads threads and a merge buffer
+void parallelSort (vector<int64_t>& keys, int numThreads);
+#endif
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+#include "TimeSeries.h"
+
+void shiftTimes (int64_t* times, long n, int64_t offset)
+{
+  for (long i = 0; i < n; i++) times[i] += offset;
+}
+
+void differences (const int64_t* times, long n, int64_t previous,
+                  int64_t* out)
+{
+  if (n == 0) return;
+  out[0] = times[0] - previous;
+  for (long i = 1; i < n; i++) out[i] = times[i] - times[i-1];
+}
+
+long markAfter (const int64_t* times, long n, const Time& time, uint8_t* out)
+{
+  int64_t t = time.nanos;
+  long count = 0;
+  for (long i = 0; i < n; i++) {
+    out[i] = times[i] > t;
+    count += out[i];
+  }
+  return count;
+}
+
+void toSeconds (const int64_t* times, long n, double* out)
+{
+  const double scale = 1.0 / NANOS_PER_SECOND;
+  for (long i = 0; i < n; i++) out[i] = times[i] * scale;
+}
+
+void WindowStats::clear (int64_t s)
+{
+  start = s;
+  count = 0;
+  sum = 0;
+  min = 0;
+  max = 0;
+}
+
+void WindowStats::add (double value)
+{
+  if (count == 0) {
+    min = value;
+    max = value;
+  }
+  min = std::min (min, value);
+  max = std::max (max, value);
+  sum += value;
+  count++;
+}
+
+void WindowStats::merge (const WindowStats& other)
+{
+  if (other.count == 0) return;
+  if (count == 0) {
+    min = other.min;
+    max = other.max;
+  }
+  min = std::min (min, other.min);
+  max = std::max (max, other.max);
+  sum += other.sum;
+  count += other.count;
+}
+
+WindowAggregator::WindowAggregator (const Time& start, int64_t w, int64_t s)
+{
+  if (s <= 0 || w < s || w % s != 0) {
+    cout << "WindowAggregator needs a positive step that divides the width"
+         << " (width " << w << ", step " << s << ")" << endl;
+    exit (1);
+  }
+  origin = start.nanos;
+  width = w;
+  step = s;
+  panesPerWindow = (int) (width / step);
+  panes.resize (panesPerWindow);
+  pane = 0;
+  lastEvent = 0;
+  started = false;
+}
+
+// Ends the current pane and emits the window that ends with it, unless
+// that window would start before origin.
+void WindowAggregator::closePane (vector<WindowStats>& windows)
+{
+  if (pane >= panesPerWindow - 1) {
+    WindowStats window;
+    window.clear (origin + (pane - panesPerWindow + 1) * step);
+    for (int k = 0; k < panesPerWindow; k++) window.merge (panes[k]);
+    if (window.count > 0) windows.push_back (window);
+  }
+
+  pane++;
+  panes[pane % panesPerWindow].clear (origin + pane * step);
+}
+
+void WindowAggregator::add (const int64_t* times, const double* values,
+                            long n, vector<WindowStats>& windows)
+{
+  long i = 0;
+  if (!started) {
+    // until the first window starts there is nothing to add to
+    while (i < n && times[i] < origin) i++;
+    if (i == n) return;
+    pane = (times[i] - origin) / step;
+    lastEvent = pane;
+    for (int k = 0; k < panesPerWindow; k++) panes[k].clear (0);
+    panes[pane % panesPerWindow].clear (origin + pane * step);
+    started = true;
+  }
+  while (i < n) {
+    // the run of events that fall in the current pane
+    WindowStats& current = panes[pane % panesPerWindow];
+    int64_t paneEnd = origin + (pane + 1) * step;
+    long j = i;
+    while (j < n && times[j] < paneEnd) current.add (values[j++]);
+    if (j > i) lastEvent = pane;
+    if (j == n) break;
+    i = j;
+
+    long p = (times[i] - origin) / step;
+    while (pane < p) {
+      // once a whole window has passed since the last event every
+      // window up to p is empty, so jump straight there
+      if (pane - lastEvent >= panesPerWindow) {
+        pane = p;
+        panes[pane % panesPerWindow].clear (origin + pane * step);
+        break;
+      }
+      closePane (windows);
+    }
+  }
+}
+
+void WindowAggregator::finish (vector<WindowStats>& windows)
+{
+  if (!started) return;
+  // close the windows that still hold the last events
+  while (pane - lastEvent < panesPerWindow) closePane (windows);
+  started = false;
+}
@@ -0,0 +1,82 @@
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+#include <stdint.h>
+#include <vector>
+#include "Time.h"
+using namespace std;
+
+// Events stored as columns: one contiguous array of timestamps (as
+// nanosecond counts, like Time) and one of values.  The bulk
+// operations are plain loops over the columns, which the compiler
+// vectorizes, instead of a call per Time.  The functions on raw
+// pointers work on any slice, so a long series can be streamed through
+// them a chunk at a time.
+struct TimeSeries {
+  vector<int64_t> times;
+  vector<double> values;
+
+  long size () const { return times.size(); }
+  void reserve (long n) { times.reserve (n);  values.reserve (n); }
+  void append (const Time& time, double value) {
+    times.push_back (time.nanos);
+    values.push_back (value);
+  }
+  Time time (long i) const { return Time::fromNanos (times[i]); }
+};
+
+// times[i] += offset
+void shiftTimes (int64_t* times, long n, int64_t offset);
+
+// out[i] = times[i] - times[i-1], with out[0] = times[0] - previous
+void differences (const int64_t* times, long n, int64_t previous,
+                  int64_t* out);
+
+// out[i] = 1 if times[i] is after time, else 0; returns how many are
+long markAfter (const int64_t* times, long n, const Time& time,
+                uint8_t* out);
+
+// out[i] = times[i] in seconds
+void toSeconds (const int64_t* times, long n, double* out);
+
+// count, sum, min and max of the values in one window
+struct WindowStats {
+  int64_t start;        // nanoseconds, like Time
+  long count;
+  double sum, min, max;
+
+  void clear (int64_t s);
+  void add (double value);
+  void merge (const WindowStats& other);
+  double mean () const { return count ? sum / count : 0; }
+};
+
+// Aggregates a stream of events, in time order, over windows width
+// nanoseconds long that start every step nanoseconds from origin.
+// No window starts before origin, so events before it belong to no
+// window and are dropped.
+// With step == width the windows tumble; with a smaller step they
+// slide and overlap.  step must be positive and width a multiple of
+// it, or the constructor stops the program.  Each step
+// is summarized as one "pane" and a window is the merge of its last
+// width / step panes, so every event is touched once and only the
+// panes of one window are kept, however long the stream is.  Windows
+// with no events are left out.
+struct WindowAggregator {
+  int64_t origin, width, step;
+  int panesPerWindow;
+  vector<WindowStats> panes;    // a ring of the most recent panes
+  long pane;                    // index of the pane being filled
+  long lastEvent;               // the pane of the latest event
+  bool started;
+
+  WindowAggregator (const Time& origin, int64_t width, int64_t step);
+
+  // appends the windows that these events complete to windows
+  void add (const int64_t* times, const double* values, long n,
+            vector<WindowStats>& windows);
+  // the windows still open at the end of the stream
+  void finish (vector<WindowStats>& windows);
+
+  void closePane (vector<WindowStats>& windows);
+};
+#endif
@@ -0,0 +1,215 @@
+#include "TimerWheel.h"
+
+const int64_t LEVEL_RANGE[] = { 1LL << 8, 1LL << 16, 1LL << 24, 1LL << 32 };
+
+TimerWheel::TimerWheel (const Time& start, int64_t tick, int capacity)
+{
+  origin = start.nanos;
+  tickNanos = tick;
+  now = 0;
+  freeList = -1;
+  pending = 0;
+  nodes.reserve (capacity);
+  for (int i = 0; i < LEVELS * SLOTS; i++) heads[i] = -1;
+  for (int i = 0; i < LEVELS * SLOTS / 64; i++) occupied[i] = 0;
+}
+
+// rounded up, so that a timer never fires before its time
+int64_t TimerWheel::toTick (const Time& time) const
+{
+  int64_t n = time.nanos - origin;
+  if (n <= 0) return 0;
+  return (n + tickNanos - 1) / tickNanos;
+}
+
+int32_t TimerWheel::allocate ()
+{
+  if (freeList < 0) {
+    Node node;
+    node.generation = 0;
+    nodes.push_back (node);
+    return (int32_t) nodes.size() - 1;
+  }
+  int32_t index = freeList;
+  freeList = nodes[index].next;
+  return index;
+}
+
+void TimerWheel::release (int32_t index)
+{
+  Node& node = nodes[index];
+  node.bucket = -1;
+  node.generation++;
+  node.next = freeList;
+  freeList = index;
+}
+
+// Puts a node in the lowest level that reaches its expiry.  Timers
+// further away than the top level can see go in its last slot and are
+// looked at again when that slot cascades.
+void TimerWheel::insert (int32_t index)
+{
+  Node& node = nodes[index];
+  int64_t expires = node.expires;
+  int64_t delta = expires - now;
+  int level = 0;
+  while (level < LEVELS - 1 && delta >= LEVEL_RANGE[level]) level++;
+  if (delta >= LEVEL_RANGE[LEVELS - 1]) {
+    expires = now + LEVEL_RANGE[LEVELS - 1] - 1;
+  }
+  int slot = (int) ((expires >> (SLOT_BITS * level)) & (SLOTS - 1));
+  int bucket = level * SLOTS + slot;
+
+  node.bucket = bucket;
+  node.prev = -1;
+  node.next = heads[bucket];
+  if (node.next >= 0) nodes[node.next].prev = index;
+  heads[bucket] = index;
+  occupied[bucket / 64] |= 1ULL << (bucket % 64);
+}
+
+void TimerWheel::unlink (int32_t index)
+{
+  Node& node = nodes[index];
+  int bucket = node.bucket;
+  if (node.prev >= 0) nodes[node.prev].next = node.next;
+  else heads[bucket] = node.next;
+  if (node.next >= 0) nodes[node.next].prev = node.prev;
+  if (heads[bucket] < 0) occupied[bucket / 64] &= ~(1ULL << (bucket % 64));
+}
+
+TimerId TimerWheel::schedule (const Time& when, uint64_t data)
+{
+  int32_t index = allocate ();
+  Node& node = nodes[index];
+  int64_t tick = toTick (when);
+  // the current tick has already been processed
+  node.expires = (tick > now) ? tick : now + 1;
+  node.data = data;
+  insert (index);
+  pending++;
+  return ((TimerId) node.generation << 32) | (uint32_t) index;
+}
+
+bool TimerWheel::cancel (TimerId id)
+{
+  uint32_t index = (uint32_t) id;
+  uint32_t generation = (uint32_t) (id >> 32);
+  if (index >= nodes.size()) return false;
+  Node& node = nodes[index];
+  if (node.generation != generation || node.bucket < 0) return false;
+  unlink (index);
+  release (index);
+  pending--;
+  return true;
+}
+
+void TimerWheel::submit (const Time& when, uint64_t data)
+{
+  Submission s;
+  s.expires = toTick (when);
+  s.data = data;
+  lock_guard<mutex> guard (submitLock);
+  submitted.push_back (s);
+}
+
+void TimerWheel::drainSubmissions ()
+{
+  vector<Submission> batch;
+  {
+    lock_guard<mutex> guard (submitLock);
+    if (submitted.empty ()) return;
+    batch.swap (submitted);
+  }
+  for (int i = 0; i < batch.size(); i++) {
+    int32_t index = allocate ();
+    Node& node = nodes[index];
+    node.expires = (batch[i].expires > now) ? batch[i].expires : now + 1;
+    node.data = batch[i].data;
+    insert (index);
+    pending++;
+  }
+  // hand the buffer back so the next round does not allocate
+  lock_guard<mutex> guard (submitLock);
+  if (submitted.empty ()) {
+    batch.clear ();
+    submitted.swap (batch);
+  }
+}
+
+// moves every timer in the current slot of a level down the wheel
+void TimerWheel::cascade (int level)
+{
+  int slot = (int) ((now >> (SLOT_BITS * level)) & (SLOTS - 1));
+  int bucket = level * SLOTS + slot;
+  int32_t index = heads[bucket];
+  heads[bucket] = -1;
+  occupied[bucket / 64] &= ~(1ULL << (bucket % 64));
+  while (index >= 0) {
+    int32_t next = nodes[index].next;
+    insert (index);
+    index = next;
+  }
+}
+
+// fires the whole level-0 slot for the current tick
+long TimerWheel::expire (vector<uint64_t>& expired)
+{
+  int bucket = (int) (now & (SLOTS - 1));
+  int32_t index = heads[bucket];
+  if (index < 0) return 0;
+  heads[bucket] = -1;
+  occupied[bucket / 64] &= ~(1ULL << (bucket % 64));
+  long count = 0;
+  while (index >= 0) {
+    int32_t next = nodes[index].next;
+    expired.push_back (nodes[index].data);
+    release (index);
+    index = next;
+    count++;
+  }
+  pending -= count;
+  return count;
+}
+
+long TimerWheel::advance (const Time& time, vector<uint64_t>& expired)
+{
+  drainSubmissions ();
+  int64_t target = (time.nanos - origin) / tickNanos;
+  long count = 0;
+  while (now < target) {
+    // with nothing pending at any level, no tick in between can fire
+    if (pending == 0) {
+      now = target;
+      break;
+    }
+    // skip straight to the next occupied level-0 slot, or the next
+    // point where a higher level cascades, whichever comes first
+    int64_t boundary = (now | (SLOTS - 1)) + 1;
+    int64_t next = boundary;
+    int from = (int) ((now + 1) & (SLOTS - 1));
+    for (int word = from / 64; from > 0 && word < SLOTS / 64; word++) {
+      uint64_t bits = occupied[word];
+      if (word == from / 64) bits &= ~0ULL << (from % 64);
+      if (bits) {
+        next = (now & ~(int64_t) (SLOTS - 1)) + word * 64
+               + __builtin_ctzll (bits);
+        break;
+      }
+    }
+    if (next > target) next = target;
+    now = next;
+
+    if ((now & (SLOTS - 1)) == 0) {
+      // higher levels first, so their timers can fall all the way down
+      int level = 1;
+      while (level < LEVELS - 1 &&
+             ((now >> (SLOT_BITS * level)) & (SLOTS - 1)) == 0) {
+        level++;
+      }
+      for (; level >= 1; level--) cascade (level);
+    }
+    count += expire (expired);
+  }
+  return count;
+}
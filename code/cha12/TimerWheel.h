@@ -0,0 +1,89 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+#include "Time.h"
+using namespace std;
+
+// A hierarchical timing wheel: a scheduler for very many timeouts that
+// inserts and cancels in constant time.  Time is counted in ticks of a
+// fixed length.  Level 0 has one slot for each of the next 256 ticks,
+// level 1 one slot for each of the next 256 runs of 256 ticks, and so
+// on up to level 3, which covers 2^32 ticks.  A timer goes into the
+// lowest level whose range reaches it.  When the clock crosses into a
+// new slot of a higher level, the timers in that slot are moved down
+// ("cascaded") to where they belong now, and each level-0 slot is
+// expired as a whole batch when its tick arrives.
+//
+// Timers live in one pool of nodes and the slot lists are linked
+// through the nodes by index, so after the pool has grown nothing is
+// allocated.  A timer id carries a generation count, so cancelling a
+// timer that has already fired or been cancelled is safely ignored.
+//
+// The wheel itself is not thread-safe: one thread owns it and calls
+// schedule, cancel and advance.  Other threads can hand it timers with
+// submit, which only takes a lock on a small queue that the owner
+// drains at the start of each advance.
+typedef uint64_t TimerId;
+
+struct TimerWheel {
+  static const int LEVELS = 4;
+  static const int SLOT_BITS = 8;
+  static const int SLOTS = 1 << SLOT_BITS;
+
+  struct Node {
+    int64_t expires;      // in ticks
+    int32_t next, prev;   // links in a slot list, or the free list
+    int32_t bucket;       // level * SLOTS + slot, or -1 if free
+    uint32_t generation;
+    uint64_t data;
+  };
+
+  struct Submission {
+    int64_t expires;
+    uint64_t data;
+  };
+
+  int64_t origin, tickNanos;
+  int64_t now;                       // the last tick processed
+  vector<Node> nodes;
+  int32_t freeList;
+  int32_t heads[LEVELS * SLOTS];     // -1 for an empty slot
+  uint64_t occupied[LEVELS * SLOTS / 64];
+  long pending;
+
+  mutex submitLock;
+  vector<Submission> submitted;
+
+  // ticks of tickNanos nanoseconds, counted from start
+  TimerWheel (const Time& start, int64_t tickNanos = 1000000,
+              int capacity = 0);
+
+  // Timers never fire early: one due at when fires on the first advance
+  // to a time at or after it.  The data comes back when it fires.
+  TimerId schedule (const Time& when, uint64_t data);
+  bool cancel (TimerId id);
+
+  // schedule, callable from any thread; these timers can't be cancelled
+  void submit (const Time& when, uint64_t data);
+
+  // Processes every tick up to now, appending the data of the timers
+  // that fire to expired.  Returns how many fired.
+  long advance (const Time& now, vector<uint64_t>& expired);
+
+  long size () const { return pending; }
+
+  int64_t toTick (const Time& time) const;
+  void insert (int32_t index);
+  void unlink (int32_t index);
+  int32_t allocate ();
+  void release (int32_t index);
+  void cascade (int level);
+  long expire (vector<uint64_t>& expired);
+  void drainSubmissions ();
+
+  TimerWheel (const TimerWheel&) = delete;
+  void operator= (const TimerWheel&) = delete;
+};
+#endif
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+#include "Time.h"
+#include "TimeIndex.h"
+
+// Builds a TimeIndex over n random times of day (100 million by
+// default) and answers "how many events between t1 and t2" three ways:
+// scanning every Time with after, one range query at a time, and in
+// batches.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+// the events from <= t <= to, the way it was done before
+long scan (const vector<Time>& events, const Time& from, const Time& to)
+{
+  long count = 0;
+  for (long i = 0; i < events.size(); i++) {
+    if (!from.after (events[i]) && !events[i].after (to)) count++;
+  }
+  return count;
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 100000000;
+  if (argc > 1) n = atol (argv[1]);
+  long numQueries = 1000000;
+  int maxThreads = thread::hardware_concurrency ();
+  if (maxThreads < 1) maxThreads = 1;
+
+  mt19937_64 rng (17);
+  const int64_t DAY = 24 * NANOS_PER_HOUR;
+  vector<Time> events (n, Time (0.0));
+  for (long i = 0; i < n; i++) {
+    events[i] = Time::fromNanos ((int64_t) (rng () % DAY));
+  }
+  cout << n << " events" << endl;
+
+  for (int threads = 1; threads <= maxThreads; threads *= 2) {
+    auto start = chrono::steady_clock::now ();
+    TimeIndex index (events, threads);
+    printf ("build with %d thread(s): %.2f s\n", threads, seconds (start));
+  }
+  TimeIndex index (events, maxThreads);
+
+  // the bread example, then a minute and a second
+  Time from[] = { Time (9, 14, 30.0), Time (17, 0, 0.0), Time (3, 3, 3.0) };
+  Time to[] = { Time (12, 49, 30.0), Time (17, 1, 0.0), Time (3, 3, 4.0) };
+  printf ("\nrange\t\t\tevents\t\tscan s\t\tindex s\n");
+  for (int k = 0; k < 3; k++) {
+    auto start = chrono::steady_clock::now ();
+    long scanned = scan (events, from[k], to[k]);
+    double tScan = seconds (start);
+    start = chrono::steady_clock::now ();
+    TimeSpan span = index.range (from[k], to[k]);
+    double tIndex = seconds (start);
+    printf ("%02d:%02d:%02.0f-%02d:%02d:%02.0f\t%ld%s\t%.3g\t\t%.3g\n",
+            from[k].hour (), from[k].minute (), from[k].second (),
+            to[k].hour (), to[k].minute (), to[k].second (), span.size(),
+            span.size() == scanned ? "" : " (WRONG)", tScan, tIndex);
+  }
+
+  // many short ranges, random widths up to a minute
+  vector<Time> qFrom (numQueries, Time (0.0)), qTo (numQueries, Time (0.0));
+  for (long i = 0; i < numQueries; i++) {
+    int64_t t = (int64_t) (rng () % DAY);
+    qFrom[i] = Time::fromNanos (t);
+    qTo[i] = Time::fromNanos (t + (int64_t) (rng () % NANOS_PER_MINUTE));
+  }
+  vector<TimeSpan> one (numQueries), batch (numQueries);
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < numQueries; i++) {
+    one[i] = index.range (qFrom[i], qTo[i]);
+  }
+  double tOne = seconds (start);
+  start = chrono::steady_clock::now ();
+  index.ranges (qFrom.data(), qTo.data(), numQueries, batch.data());
+  double tBatch = seconds (start);
+
+  long mismatches = 0, total = 0;
+  for (long i = 0; i < numQueries; i++) {
+    if (one[i].first != batch[i].first || one[i].last != batch[i].last) {
+      mismatches++;
+    }
+    total += one[i].size();
+  }
+  // spot-check a few against the sorted keys directly
+  for (long i = 0; i < numQueries; i += numQueries / 16) {
+    const int64_t* k = index.keys.data();
+    long lo = one[i].first - k, hi = one[i].last - k;
+    bool ok = (lo == 0 || k[lo-1] < qFrom[i].nanos) &&
+              (lo == n || k[lo] >= qFrom[i].nanos) &&
+              (hi == 0 || k[hi-1] <= qTo[i].nanos) &&
+              (hi == n || k[hi] > qTo[i].nanos);
+    if (!ok) mismatches++;
+  }
+  printf ("\n%ld random ranges (%ld events in all, %ld mismatches)\n",
+          numQueries, total, mismatches);
+  printf ("one at a time\t%.3g ranges/s\n", numQueries / tOne);
+  printf ("batched\t\t%.3g ranges/s\t(%.2fx)\n", numQueries / tBatch,
+          tOne / tBatch);
+  return 0;
+}
@@ -0,0 +1,192 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "Time.h"
+#include "TimeSeries.h"
+
+// Streams a synthetic series of n events (a billion by default), about
+// one per millisecond, through the column operations and the window
+// aggregators a chunk at a time, and reports events per second for
+// each.  The per-Time loop with add and convertToSeconds is timed on
+// the same chunks for comparison.  First the aggregator is checked
+// against a brute-force count on small series fed in odd-sized pieces,
+// some of them starting before the origin.
+
+const long CHUNK = 1 << 20;
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+// a small xorshift generator; the data only has to look irregular
+struct Events {
+  uint64_t state;
+  int64_t now;
+
+  Events (int64_t start) { state = 88172645463325252ULL;  now = start; }
+
+  uint64_t next () {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  void fill (int64_t* times, double* values, long n) {
+    for (long i = 0; i < n; i++) {
+      uint64_t r = next ();
+      now += (int64_t) (r % 2000000);      // up to 2 ms apart
+      times[i] = now;
+      values[i] = (double) (r >> 40) / (1 << 24);
+    }
+  }
+};
+
+bool sameStats (const WindowStats& a, const WindowStats& b)
+{
+  return a.start == b.start && a.count == b.count &&
+         fabs (a.sum - b.sum) < 1e-9 * (1 + fabs (b.sum)) &&
+         a.min == b.min && a.max == b.max;
+}
+
+// the events start lead nanoseconds after the origin (before it if
+// lead is negative)
+bool check (int64_t width, int64_t step, int64_t lead)
+{
+  Time origin (9, 0, 0.0);
+  long n = 200000;
+  vector<int64_t> times (n);
+  vector<double> values (n);
+  Events events (origin.nanos + lead);
+  events.fill (times.data(), values.data(), n);
+  // leave a long gap in the middle
+  for (long i = n / 2; i < n; i++) times[i] += 50 * NANOS_PER_SECOND;
+
+  vector<WindowStats> got;
+  WindowAggregator agg (origin, width, step);
+  for (long i = 0; i < n; ) {
+    long len = min (n - i, 1 + (long) (events.next () % 5000));
+    agg.add (times.data() + i, values.data() + i, len, got);
+    i += len;
+  }
+  agg.finish (got);
+
+  vector<WindowStats> expect;
+  int64_t first = origin.nanos + ((times[0] - origin.nanos) / step) * step
+                  - width + step;
+  if (first < origin.nanos) first = origin.nanos;
+  for (int64_t s = first; s <= times[n-1]; s += step) {
+    WindowStats w;
+    w.clear (s);
+    for (long i = 0; i < n; i++) {
+      if (times[i] >= s && times[i] < s + width) w.add (values[i]);
+    }
+    if (w.count > 0) expect.push_back (w);
+  }
+
+  if (got.size() != expect.size()) return false;
+  for (long k = 0; k < got.size(); k++) {
+    if (!sameStats (got[k], expect[k])) return false;
+  }
+  return true;
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 1000000000;
+  if (argc > 1) n = atol (argv[1]);
+
+  bool ok = check (NANOS_PER_SECOND, NANOS_PER_SECOND, 5 * NANOS_PER_SECOND)
+            && check (10 * NANOS_PER_SECOND, NANOS_PER_SECOND,
+                      5 * NANOS_PER_SECOND)
+            && check (NANOS_PER_SECOND, NANOS_PER_SECOND,
+                      -5 * NANOS_PER_SECOND)
+            && check (10 * NANOS_PER_SECOND, NANOS_PER_SECOND,
+                      -5 * NANOS_PER_SECOND);
+  cout << "windows match brute force: " << (ok ? "yes" : "NO") << endl;
+
+  Time origin (0, 0, 0.0);
+  Events events (origin.nanos);
+  vector<int64_t> times (CHUNK), deltas (CHUNK);
+  vector<double> values (CHUNK), secs (CHUNK);
+  vector<uint8_t> mask (CHUNK);
+  vector<Time> objects (CHUNK, Time (0.0));
+  Time hour (1, 0, 0.0), minusHour = Time::fromNanos (-NANOS_PER_HOUR);
+  WindowAggregator tumbling (origin, NANOS_PER_SECOND, NANOS_PER_SECOND);
+  WindowAggregator sliding (origin, 60 * NANOS_PER_SECOND, NANOS_PER_SECOND);
+  vector<WindowStats> windows;
+
+  double tObjects = 0, tShift = 0, tSeconds = 0, tDiff = 0, tAfter = 0;
+  double tTumble = 0, tSlide = 0;
+  long after = 0, numTumbling = 0, numSliding = 0;
+  double checksum = 0;
+
+  for (long done = 0; done < n; done += CHUNK) {
+    long m = min (CHUNK, n - done);
+    events.fill (times.data(), values.data(), m);
+    for (long i = 0; i < m; i++) objects[i] = Time::fromNanos (times[i]);
+
+    // one Time at a time: shift by an hour, then read out seconds
+    auto start = chrono::steady_clock::now ();
+    for (long i = 0; i < m; i++) {
+      objects[i] = objects[i].add (hour);
+      secs[i] = objects[i].convertToSeconds ();
+    }
+    tObjects += seconds (start);
+    checksum += secs[m-1];
+
+    start = chrono::steady_clock::now ();
+    shiftTimes (times.data(), m, hour.nanos);
+    tShift += seconds (start);
+    start = chrono::steady_clock::now ();
+    toSeconds (times.data(), m, secs.data());
+    tSeconds += seconds (start);
+    checksum -= secs[m-1];
+    shiftTimes (times.data(), m, minusHour.nanos);
+
+    start = chrono::steady_clock::now ();
+    differences (times.data(), m, times[0], deltas.data());
+    tDiff += seconds (start);
+
+    start = chrono::steady_clock::now ();
+    after += markAfter (times.data(), m, Time (12, 0, 0.0), mask.data());
+    tAfter += seconds (start);
+
+    start = chrono::steady_clock::now ();
+    windows.clear ();
+    tumbling.add (times.data(), values.data(), m, windows);
+    numTumbling += windows.size();
+    tTumble += seconds (start);
+
+    start = chrono::steady_clock::now ();
+    windows.clear ();
+    sliding.add (times.data(), values.data(), m, windows);
+    numSliding += windows.size();
+    tSlide += seconds (start);
+  }
+  windows.clear ();
+  tumbling.finish (windows);
+  numTumbling += windows.size();
+  windows.clear ();
+  sliding.finish (windows);
+  numSliding += windows.size();
+
+  printf ("\n%ld events, %ld one-second windows, %ld sliding minutes\n",
+          n, numTumbling, numSliding);
+  printf ("(checksum %g, %ld after noon)\n\n", checksum, after);
+  printf ("operation\t\tevents/s\n");
+  printf ("Time add+seconds\t%.3g\n", n / tObjects);
+  printf ("shift+toSeconds\t\t%.3g\t(%.1fx)\n", n / (tShift + tSeconds),
+          tObjects / (tShift + tSeconds));
+  printf ("differences\t\t%.3g\n", n / tDiff);
+  printf ("markAfter\t\t%.3g\n", n / tAfter);
+  printf ("tumbling 1 s\t\t%.3g\n", n / tTumble);
+  printf ("sliding 60 s / 1 s\t%.3g\n", n / tSlide);
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "Time.h"
+#include "TimeFormat.h"
+
+// Checks that formatTime and parseTime agree on every millisecond of a
+// day and reject bad input, then times formatting and parsing a log of
+// timestamps both ways: with iostreams and with the fixed-width code.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+bool check ()
+{
+  char text[TIME_TEXT_SIZE + 1] = { 0 };
+  for (int64_t ms = 0; ms < 24 * 3600 * 1000LL; ms++) {
+    Time t = Time::fromNanos (ms * 1000000);
+    formatTime (t, text);
+    char expect[32];
+    sprintf (expect, "%02d:%02d:%02d.%03d", t.hour (), t.minute (),
+             (int) (ms / 1000 % 60), (int) (ms % 1000));
+    Time back (0.0);
+    if (string (text) != expect || !parseTime (text, back) ||
+        back.nanos != t.nanos) {
+      cout << "mismatch at " << expect << ": got " << text << endl;
+      return false;
+    }
+  }
+
+  const char* bad[] = { "12:60:00.000", "12:00:60.000", "1a:00:00.000",
+                        "12-00:00.000", "12:00:00,000", "12:00:00.00/",
+                        "12:00:00.:00", " 2:00:00.000" };
+  for (const char* s : bad) {
+    Time t (0.0);
+    if (parseTime (s, t)) {
+      cout << "accepted " << s << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 5000000;
+  if (argc > 1) n = atol (argv[1]);
+
+  cout << "round trip and validation: " << (check () ? "ok" : "FAILED")
+       << endl;
+
+  srand (17);
+  vector<Time> times;
+  for (long i = 0; i < n; i++) {
+    int64_t ms = (int64_t) rand () % (24 * 3600 * 1000);
+    times.push_back (Time::fromNanos (ms * 1000000));
+  }
+
+  // iostream formatting, as print does, but with '\n' instead of endl
+  auto start = chrono::steady_clock::now ();
+  ostringstream os;
+  os.fill ('0');
+  for (long i = 0; i < n; i++) {
+    const Time& t = times[i];
+    int64_t ms = t.nanos / 1000000;
+    os.width (2);  os << t.hour () << ':';
+    os.width (2);  os << t.minute () << ':';
+    os.width (2);  os << ms / 1000 % 60 << '.';
+    os.width (3);  os << ms % 1000 << '\n';
+  }
+  string streamText = os.str ();
+  double formatStream = seconds (start);
+
+  start = chrono::steady_clock::now ();
+  vector<char> buffer (n * (TIME_TEXT_SIZE + 1));
+  size_t size = formatTimes (times.data(), n, buffer.data());
+  double formatFast = seconds (start);
+  bool sameText = (string (buffer.data(), size) == streamText);
+
+  start = chrono::steady_clock::now ();
+  istringstream is (streamText);
+  vector<Time> streamTimes;
+  streamTimes.reserve (n);
+  int h, m;
+  double s;
+  char c1, c2;
+  while (is >> h >> c1 >> m >> c2 >> s) {
+    streamTimes.push_back (Time (h, m, s));
+  }
+  double parseStream = seconds (start);
+
+  start = chrono::steady_clock::now ();
+  vector<Time> fastTimes;
+  fastTimes.reserve (n);
+  long bad = parseTimes (buffer.data(), size, fastTimes);
+  double parseFast = seconds (start);
+
+  bool sameTimes = (fastTimes.size() == n && streamTimes.size() == n);
+  for (long i = 0; sameTimes && i < n; i++) {
+    if (fastTimes[i].nanos != times[i].nanos) sameTimes = false;
+    if (streamTimes[i].nanos != times[i].nanos) sameTimes = false;
+  }
+
+  printf ("\n\t\ttimestamps/s\n");
+  printf ("format stream\t%.3g\n", n / formatStream);
+  printf ("format fast\t%.3g\t(%.1fx, text %s)\n", n / formatFast,
+          formatStream / formatFast, sameText ? "identical" : "DIFFERS");
+  printf ("parse stream\t%.3g\n", n / parseStream);
+  printf ("parse fast\t%.3g\t(%.1fx, %ld bad lines, times %s)\n",
+          n / parseFast, parseStream / parseFast, bad,
+          sameTimes ? "identical" : "DIFFER");
+  return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+#include "Time.h"
+#include "TimerWheel.h"
+
+// Schedules n timers (10 million by default) spread over ten minutes,
+// cancels half of them, and runs the clock forward a millisecond at a
+// time until the rest have fired.  The same work is timed on a
+// priority queue ordered with Time::after, which has no cancel, so
+// cancelled entries are only marked and skipped when they reach the
+// top.  Finally a few threads submit timers while the owner advances.
+
+const int64_t TICK = 1000000;                  // 1 ms
+const int64_t SPAN = 10 * NANOS_PER_MINUTE;
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+struct Entry {
+  Time when;
+  uint64_t data;
+};
+
+struct Later {
+  bool operator() (const Entry& a, const Entry& b) const {
+    return a.when.after (b.when);
+  }
+};
+
+void report (const char* name, long count, double t)
+{
+  printf ("%-22s%.3g/s\n", name, count / t);
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 10000000;
+  if (argc > 1) n = atol (argv[1]);
+
+  Time start (9, 0, 0.0);
+  mt19937_64 rng (17);
+  vector<int64_t> due (n);
+  for (long i = 0; i < n; i++) {
+    due[i] = start.nanos + (int64_t) (rng () % SPAN);
+  }
+  vector<long> victims (n / 2);
+  for (long i = 0; i < n / 2; i++) victims[i] = (long) (rng () % n);
+
+  cout << n << " timers" << endl;
+  cout << "\ntiming wheel:" << endl;
+  {
+    TimerWheel wheel (start, TICK, n);
+    vector<TimerId> ids (n);
+    auto t0 = chrono::steady_clock::now ();
+    for (long i = 0; i < n; i++) {
+      ids[i] = wheel.schedule (Time::fromNanos (due[i]), i);
+    }
+    report ("insert", n, seconds (t0));
+
+    vector<char> cancelled (n, 0);
+    long numCancelled = 0;
+    t0 = chrono::steady_clock::now ();
+    for (long i = 0; i < victims.size(); i++) {
+      if (wheel.cancel (ids[victims[i]])) {
+        cancelled[victims[i]] = 1;
+        numCancelled++;
+      }
+    }
+    report ("cancel", victims.size(), seconds (t0));
+
+    vector<uint64_t> expired;
+    expired.reserve (n);
+    long fired = 0, early = 0, late = 0;
+    t0 = chrono::steady_clock::now ();
+    for (int64_t t = start.nanos; t <= start.nanos + SPAN + TICK; t += TICK) {
+      expired.clear ();
+      fired += wheel.advance (Time::fromNanos (t), expired);
+      for (long k = 0; k < expired.size(); k++) {
+        int64_t d = due[expired[k]];
+        if (d > t || cancelled[expired[k]]) early++;
+        if (t - d >= TICK) late++;
+      }
+    }
+    report ("expire", fired, seconds (t0));
+    printf ("fired %ld of %ld, %ld wrong, %ld late, %ld left\n", fired,
+            n - numCancelled, early, late, wheel.size ());
+  }
+
+  cout << "\npriority queue:" << endl;
+  {
+    priority_queue<Entry, vector<Entry>, Later> heap;
+    auto t0 = chrono::steady_clock::now ();
+    for (long i = 0; i < n; i++) {
+      Entry e = { Time::fromNanos (due[i]), (uint64_t) i };
+      heap.push (e);
+    }
+    report ("insert", n, seconds (t0));
+
+    vector<char> cancelled (n, 0);
+    t0 = chrono::steady_clock::now ();
+    for (long i = 0; i < victims.size(); i++) cancelled[victims[i]] = 1;
+    report ("cancel (mark)", victims.size(), seconds (t0));
+
+    long fired = 0;
+    t0 = chrono::steady_clock::now ();
+    for (int64_t t = start.nanos; t <= start.nanos + SPAN + TICK; t += TICK) {
+      Time now = Time::fromNanos (t);
+      while (!heap.empty () && !heap.top().when.after (now)) {
+        if (!cancelled[heap.top().data]) fired++;
+        heap.pop ();
+      }
+    }
+    report ("expire", fired, seconds (t0));
+  }
+
+  cout << "\nsubmission queue:" << endl;
+  {
+    const int PRODUCERS = 4;
+    long perThread = n / 10 / PRODUCERS;
+    TimerWheel wheel (start, TICK, n / 10);
+    vector<uint64_t> expired;
+    auto t0 = chrono::steady_clock::now ();
+    vector<thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+      producers.push_back (thread ([&, p] () {
+        for (long i = 0; i < perThread; i++) {
+          wheel.submit (Time::fromNanos (due[p * perThread + i]), i);
+        }
+      }));
+    }
+    long fired = 0;
+    int64_t t = start.nanos;
+    while (fired < PRODUCERS * perThread) {
+      fired += wheel.advance (Time::fromNanos (t), expired);
+      if (t < start.nanos + SPAN) t += TICK;
+    }
+    for (int p = 0; p < PRODUCERS; p++) producers[p].join ();
+    report ("submit and expire", fired, seconds (t0));
+  }
+  return 0;
+}
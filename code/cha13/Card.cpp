@@ -11,30 +11,28 @@ Card::Card (int s, int r) {
 
 // card member functions
 
+// built once, at compile time, instead of on every call
+static constexpr const char* SUIT_NAMES[4] = {
+  "Clubs", "Diamonds", "Hearts", "Spades"
+};
+
+static constexpr const char* RANK_NAMES[14] = {
+  "narf", "Ace", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+  "Jack", "Queen", "King"
+};
+
+// "?" for a suit or rank outside the tables rather than reading past them
+static const char* suitName (int suit) {
+  return (unsigned) suit < 4 ? SUIT_NAMES[suit] : "?";
+}
+
+static const char* rankName (int rank) {
+  return (unsigned) rank < 14 ? RANK_NAMES[rank] : "?";
+}
+
 void Card::print () const
 {
-  vector<string> suits (4, "narf");
-  suits[0] = "Clubs";
-  suits[1] = "Diamonds";
-  suits[2] = "Hearts";
-  suits[3] = "Spades";
-
-  vector<string> ranks (14, "narf");
-  ranks[1] = "Ace";
-  ranks[2] = "2";
-  ranks[3] = "3";
-  ranks[4] = "4";
-  ranks[5] = "5";
-  ranks[6] = "6";
-  ranks[7] = "7";
-  ranks[8] = "8";
-  ranks[9] = "9";
-  ranks[10] = "10";
-  ranks[11] = "Jack";
-  ranks[12] = "Queen";
-  ranks[13] = "King";
-
-  cout << ranks[rank] << " of " << suits[suit] << endl;
+  cout << rankName (rank) << " of " << suitName (suit) << endl;
 }
 
 bool Card::equals (const Card& c2) const { //as a member function
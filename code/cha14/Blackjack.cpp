@@ -0,0 +1,240 @@
+#include "Blackjack.h"
+#include <atomic>
+#include <iostream>
+#include <stdlib.h>
+#include <thread>
+
+Shoe::Shoe (int numDecks) {
+  if (numDecks < 1 || numDecks > MAX_DECKS) {
+    cout << "Shoe needs 1 to " << MAX_DECKS << " decks, not " << numDecks
+         << endl;
+    exit (1);
+  }
+  for (int k = 0; k < NUM_KINDS; k++) counts[k] = 4 * numDecks;
+  counts[9] = 16 * numDecks;
+  total = 52 * numDecks;
+}
+
+Shoe::Shoe (const Deck& deck) {
+  for (int k = 0; k < NUM_KINDS; k++) counts[k] = 0;
+  for (int i = 0; i < deck.cards.size(); i++) {
+    if (!isValidCard (deck.cards[i])) {
+      cout << "Shoe failed because the deck has an invalid card" << endl;
+      exit (1);
+    }
+    counts[kindOf (deck.cards[i].rank)]++;
+  }
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (counts[k] > (k == 9 ? MAX_TENS : MAX_OF_KIND)) {
+      cout << "Shoe failed because the deck has too many cards of kind "
+           << k << " to fit in its key" << endl;
+      exit (1);
+    }
+  }
+  total = deck.cards.size();
+}
+
+uint64_t Shoe::key () const {
+  uint64_t key = 0;
+  for (int k = 0; k < 9; k++) {
+    key |= (uint64_t) counts[k] << (6 * k);
+  }
+  return key | (uint64_t) counts[9] << 54;
+}
+
+double HandEV::best () const {
+  double ev = stand;
+  if (hit > ev) ev = hit;
+  if (doubleDown > ev) ev = doubleDown;
+  if (canSplit && split > ev) ev = split;
+  return ev;
+}
+
+// the best total of a hand, counting one ace as 11 if that doesn't bust
+static int bestTotal (int hard, bool soft)
+{
+  if (soft && hard + 10 <= 21) return hard + 10;
+  return hard;
+}
+
+Solver::Solver (const Shoe& s) : shoe (s) {}
+
+// The distribution of the dealer's final total, starting from a hand
+// worth hard (aces as 1), with soft set if it holds an ace.
+DealerOutcome Solver::dealer (int hard, bool soft)
+{
+  DealerOutcome outcome = { { 0, 0, 0, 0, 0, 0 } };
+  if (hard > 21) {
+    outcome.p[5] = 1;
+    return outcome;
+  }
+  int total = bestTotal (hard, soft);
+  if (total >= 17 || shoe.total == 0) {
+    outcome.p[total >= 17 ? total - 17 : 0] = 1;
+    return outcome;
+  }
+
+  Key key = { shoe.key (), (uint32_t) (hard | soft << 5) };
+  auto found = dealerMemo.find (key);
+  if (found != dealerMemo.end()) return found->second;
+
+  double n = shoe.total;
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (shoe.counts[k] == 0) continue;
+    double p = shoe.counts[k] / n;
+    shoe.remove (k);
+    DealerOutcome next = dealer (hard + valueOf (k), soft || k == 0);
+    shoe.putBack (k);
+    for (int i = 0; i < 6; i++) outcome.p[i] += p * next.p[i];
+  }
+  dealerMemo[key] = outcome;
+  return outcome;
+}
+
+double Solver::standEV (int playerTotal, int upcard)
+{
+  if (playerTotal > 21) return -1;
+  DealerOutcome d = dealer (valueOf (upcard), upcard == 0);
+  double ev = d.p[5];
+  for (int t = 17; t <= 21; t++) {
+    if (playerTotal > t) ev += d.p[t-17];
+    if (playerTotal < t) ev -= d.p[t-17];
+  }
+  return ev;
+}
+
+// take a card, then carry on with whichever of hit or stand is better
+double Solver::hitEV (int hard, bool soft, int upcard)
+{
+  Key key = { shoe.key (), (uint32_t) (hard | soft << 5 | upcard << 6) };
+  auto found = hitMemo.find (key);
+  if (found != hitMemo.end()) return found->second;
+
+  double ev = 0, n = shoe.total;
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (shoe.counts[k] == 0) continue;
+    double p = shoe.counts[k] / n;
+    int h = hard + valueOf (k);
+    bool s = soft || k == 0;
+    if (h > 21) {
+      ev -= p;
+      continue;
+    }
+    shoe.remove (k);
+    double stand = standEV (bestTotal (h, s), upcard);
+    double hit = hitEV (h, s, upcard);
+    shoe.putBack (k);
+    ev += p * (hit > stand ? hit : stand);
+  }
+  hitMemo[key] = ev;
+  return ev;
+}
+
+// twice the bet, exactly one more card
+double Solver::doubleEV (int hard, bool soft, int upcard)
+{
+  double ev = 0, n = shoe.total;
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (shoe.counts[k] == 0) continue;
+    double p = shoe.counts[k] / n;
+    shoe.remove (k);
+    ev += p * 2 * standEV (bestTotal (hard + valueOf (k), soft || k == 0),
+                           upcard);
+    shoe.putBack (k);
+  }
+  return ev;
+}
+
+// two hands, each starting from one card of the pair
+double Solver::splitEV (int kind, int upcard)
+{
+  double ev = 0, n = shoe.total;
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (shoe.counts[k] == 0) continue;
+    double p = shoe.counts[k] / n;
+    int hard = valueOf (kind) + valueOf (k);
+    bool soft = kind == 0 || k == 0;
+    shoe.remove (k);
+    double stand = standEV (bestTotal (hard, soft), upcard);
+    double play = stand;
+    if (kind != 0) {
+      double hit = hitEV (hard, soft, upcard);
+      if (hit > play) play = hit;
+    }
+    shoe.putBack (k);
+    ev += p * play;
+  }
+  return 2 * ev;
+}
+
+HandEV Solver::evaluate (int card1, int card2, int upcard)
+{
+  HandEV result;
+  result.card1 = card1;  result.card2 = card2;  result.upcard = upcard;
+  shoe.remove (card1);
+  shoe.remove (card2);
+  shoe.remove (upcard);
+
+  int hard = valueOf (card1) + valueOf (card2);
+  bool soft = card1 == 0 || card2 == 0;
+  result.stand = standEV (bestTotal (hard, soft), upcard);
+  result.hit = hitEV (hard, soft, upcard);
+  result.doubleDown = doubleEV (hard, soft, upcard);
+  result.canSplit = (card1 == card2);
+  result.split = result.canSplit ? splitEV (card1, upcard) : 0;
+
+  shoe.putBack (upcard);
+  shoe.putBack (card2);
+  shoe.putBack (card1);
+  return result;
+}
+
+// does the shoe hold these three cards?
+static bool canDeal (const Shoe& shoe, int card1, int card2, int upcard)
+{
+  int need[NUM_KINDS] = { 0 };
+  need[card1]++;  need[card2]++;  need[upcard]++;
+  for (int k = 0; k < NUM_KINDS; k++) {
+    if (shoe.counts[k] < need[k]) return false;
+  }
+  return true;
+}
+
+// Each thread has its own Solver, and so its own caches: no locking,
+// at the cost of some work done twice.
+vector<HandEV> solveStartingHands (const Shoe& shoe, int numThreads)
+{
+  vector<HandEV> hands;
+  for (int c1 = 0; c1 < NUM_KINDS; c1++) {
+    for (int c2 = c1; c2 < NUM_KINDS; c2++) {
+      for (int up = 0; up < NUM_KINDS; up++) {
+        HandEV hand;
+        hand.card1 = c1;  hand.card2 = c2;  hand.upcard = up;
+        hands.push_back (hand);
+      }
+    }
+  }
+
+  atomic<int> next (0);
+  auto worker = [&] () {
+    Solver solver (shoe);
+    for (;;) {
+      int i = next.fetch_add (1);
+      if (i >= hands.size()) break;
+      HandEV& hand = hands[i];
+      if (!canDeal (solver.shoe, hand.card1, hand.card2, hand.upcard)) {
+        hand.stand = hand.hit = hand.doubleDown = hand.split = 0;
+        hand.canSplit = false;
+        continue;
+      }
+      hand = solver.evaluate (hand.card1, hand.card2, hand.upcard);
+    }
+  };
+
+  if (numThreads < 1) numThreads = 1;
+  vector<thread> threads;
+  for (int i = 1; i < numThreads; i++) threads.push_back (thread (worker));
+  worker ();
+  for (int i = 0; i < threads.size(); i++) threads[i].join ();
+  return hands;
+}
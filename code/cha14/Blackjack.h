@@ -0,0 +1,99 @@
+#ifndef BLACKJACK_H
+#define BLACKJACK_H
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "Card.h"
+#include "Deck.h"
+using namespace std;
+
+// Blackjack only cares about ten kinds of card: ace, 2 through 9, and
+// the tens (10, jack, queen, king).  Index 0 is the ace and index 9 is
+// the tens.
+const int NUM_KINDS = 10;
+
+inline int kindOf (Rank rank)
+{
+  if (rank >= TEN) return 9;
+  return rank - 1;
+}
+
+inline int valueOf (int kind) { return kind + 1; }
+
+// What is left in the shoe, as a count per kind of card.  key () packs
+// the counts into one 64-bit integer (six bits per kind, ten for the
+// tens), which makes a cheap hash key but holds at most 63 of each of
+// the nine small kinds: 15 decks.  The constructors stop the program
+// rather than build a shoe whose key would run one count into the next.
+const int MAX_DECKS = 15;
+const int MAX_OF_KIND = 63;
+const int MAX_TENS = 1023;
+
+struct Shoe {
+  int counts[NUM_KINDS];
+  int total;
+
+  Shoe (int numDecks = 1);
+  Shoe (const Deck& deck);
+
+  uint64_t key () const;
+  void remove (int kind) { counts[kind]--;  total--; }
+  void putBack (int kind) { counts[kind]++;  total++; }
+};
+
+// the dealer's final total: 17 to 21, or bust
+struct DealerOutcome {
+  double p[6];    // p[0..4] for 17..21, p[5] for bust
+};
+
+// the expected value (in bets) of each play for one starting hand
+struct HandEV {
+  int card1, card2, upcard;    // kinds
+  double stand, hit, doubleDown, split;
+  bool canSplit;
+
+  double best () const;
+};
+
+// Works out expected values by trying every card the shoe could give,
+// remembering each result by the shoe it was computed from, since the
+// same compositions come up again and again.
+//
+// The rules are kept simple: the dealer stands on soft 17 and does not
+// peek for blackjack, naturals count as ordinary 21s, and split hands
+// may hit but not double or split again (split aces get one card).
+// Each split hand is played from the same shoe, which is the usual
+// approximation.
+struct Solver {
+  struct Key {
+    uint64_t shoe;
+    uint32_t state;
+    bool operator== (const Key& other) const {
+      return shoe == other.shoe && state == other.state;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator() (const Key& key) const {
+      uint64_t h = key.shoe * 0x9E3779B97F4A7C15ULL ^ key.state;
+      return (size_t) (h ^ (h >> 29));
+    }
+  };
+
+  Shoe shoe;
+  unordered_map<Key, DealerOutcome, KeyHash> dealerMemo;
+  unordered_map<Key, double, KeyHash> hitMemo;
+
+  Solver (const Shoe& s);
+
+  DealerOutcome dealer (int hard, bool soft);
+  double standEV (int playerTotal, int upcard);
+  double hitEV (int hard, bool soft, int upcard);
+  double doubleEV (int hard, bool soft, int upcard);
+  double splitEV (int kind, int upcard);
+  HandEV evaluate (int card1, int card2, int upcard);
+};
+
+// every starting hand against every upcard, spread over numThreads
+vector<HandEV> solveStartingHands (const Shoe& shoe, int numThreads);
+#endif
@@ -9,34 +9,86 @@ Card::Card (Suit s, Rank r) {
   suit = s;  rank = r;
 }
 
-string suitToString(Suit suit){
-    switch (suit) {
-        case CLUBS:  return "Clubs";
-        case DIAMONDS:  return "Diamonds";
-        case HEARTS:  return "Hearts";
-        case SPADES:  return "Spades";
-        default:  return "Not a valid suit";
-    }
+// built once, at compile time, instead of on every call
+static constexpr const char* SUIT_NAMES[4] = {
+  "Clubs", "Diamonds", "Hearts", "Spades"
+};
+
+static constexpr const char* RANK_NAMES[14] = {
+  "narf", "Ace", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+  "Jack", "Queen", "King"
+};
+
+// "?" for a suit or rank outside the tables rather than reading past them
+static const char* suitName (int suit) {
+  return (unsigned) suit < 4 ? SUIT_NAMES[suit] : "?";
+}
+
+static const char* rankName (int rank) {
+  return (unsigned) rank < 14 ? RANK_NAMES[rank] : "?";
+}
+
+// the short notation: one character for the rank, one for the suit
+static constexpr char SUIT_LETTERS[] = "CDHS";
+static constexpr char RANK_LETTERS[] = "?A23456789TJQK";
+
+// appends "Jack of Diamonds" and a newline to out
+void Card::write (string& out) const {
+  out += rankName (rank);
+  out += " of ";
+  out += suitName (suit);
+  out += '\n';
 }
 
 void Card::print () const {
+  string line;
+  write (line);
+  cout << line;
+}
+
+// writes the two characters of the short name ("JD") to out
+void Card::writeShort (char* out) const {
+  out[0] = (unsigned) rank < 14 ? RANK_LETTERS[rank] : '?';
+  out[1] = (unsigned) suit < 4 ? SUIT_LETTERS[suit] : '?';
+}
+
+string Card::shortName () const {
+  char name[2];
+  writeShort (name);
+  return string (name, 2);
+}
+
+// Tables from a character to its rank or suit, -1 for anything else.
+// Lower case letters are accepted too.
+struct LetterTables {
+  signed char rank[256], suit[256];
+
+  LetterTables () {
+    for (int c = 0; c < 256; c++) {
+      rank[c] = -1;  suit[c] = -1;
+    }
+    for (int r = ACE; r <= KING; r++) {
+      rank[(unsigned char) RANK_LETTERS[r]] = r;
+      rank[(unsigned char) tolower (RANK_LETTERS[r])] = r;
+    }
+    for (int s = CLUBS; s <= SPADES; s++) {
+      suit[(unsigned char) SUIT_LETTERS[s]] = s;
+      suit[(unsigned char) tolower (SUIT_LETTERS[s])] = s;
+    }
+  }
+};
+
+static const LetterTables LETTERS;
 
-  vector<string> ranks (14, "narf");
-  ranks[ACE] = "Ace";
-  ranks[TWO] = "2";
-  ranks[THREE] = "3";
-  ranks[FOUR] = "4";
-  ranks[FIVE] = "5";
-  ranks[SIX] = "6";
-  ranks[SEVEN] = "7";
-  ranks[EIGHT] = "8";
-  ranks[NINE] = "9";
-  ranks[TEN] = "10";
-  ranks[JACK] = "Jack";
-  ranks[QUEEN] = "Queen";
-  ranks[KING] = "King";
-
-  cout << ranks[rank] << " of " << suitToString(suit) << endl;
+// reads a short name like "JD" or "th"; returns false if it isn't one
+bool parseCard (const char* text, Card& card) {
+  int r = LETTERS.rank[(unsigned char) text[0]];
+  if (r < 0) return false;
+  int s = LETTERS.suit[(unsigned char) text[1]];
+  if (s < 0) return false;
+  card.rank = Rank (r);
+  card.suit = Suit (s);
+  return true;
 }
 
 bool Card::equals (const Card& c2) const {
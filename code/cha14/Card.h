@@ -2,6 +2,8 @@
 #define CARD_H
 #include <iostream>
 #include <vector>
+#include <string>
+#include <cctype>
 using namespace std;
 
 enum Suit { CLUBS, DIAMONDS, HEARTS, SPADES };
@@ -20,8 +22,28 @@ struct Card
   Card (Suit s, Rank r);
 
   void print () const;
+  void write (string& out) const;
+  void writeShort (char* out) const;
+  string shortName () const;
   bool equals (const Card& c2) const;
   bool isGreater (const Card& c2) const;
   int find (const Deck& deck) const;
 };
+
+bool parseCard (const char* text, Card& card);
+
+// Cards in the order of Card::isGreater (suit first, then rank) as
+// the integers 0 to 51.
+const int NUM_CARD_KEYS = 52;
+
+inline int cardKey (const Card& card)
+{
+  return card.suit * 13 + (card.rank - 1);
+}
+
+inline bool isValidCard (const Card& card)
+{
+  return card.suit >= CLUBS && card.suit <= SPADES &&
+         card.rank >= ACE && card.rank <= KING;
+}
 #endif
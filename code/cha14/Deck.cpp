@@ -1,5 +1,7 @@
 #include "Deck.h"
 #include "Card.h"
+#include "DeckView.h"
+#include "Ordering.h"
 
 Deck::Deck(int n) {
   vector<Card> temp (n);
@@ -20,10 +22,48 @@ Deck::Deck() {
   }
 }
 
+// builds the whole listing first and writes it out in one go
 void Deck::print () const {
+  string text;
+  text.reserve (cards.size() * 20);
   for (int i = 0; i < cards.size(); i++) {
-    cards[i].print ();
+    cards[i].write (text);
   }
+  cout.write (text.data(), text.size());
+}
+
+// the short names separated by spaces: "AC 2C 3C ..."
+void Deck::printShort () const {
+  string text (cards.size() * 3, ' ');
+  for (int i = 0; i < cards.size(); i++) {
+    cards[i].writeShort (&text[i*3]);
+  }
+  if (!text.empty()) text[text.size()-1] = '\n';
+  cout.write (text.data(), text.size());
+}
+
+// one byte per card: its key from 0 to 51
+void Deck::encode (vector<unsigned char>& out) const {
+  int start = out.size();
+  out.resize (start + cards.size());
+  for (int i = 0; i < cards.size(); i++) {
+    out[start+i] = (unsigned char) cardKey (cards[i]);
+  }
+}
+
+// the reverse of encode; returns false, leaving the deck as it was,
+// if a byte is not a card
+bool Deck::decode (const unsigned char* data, int n) {
+  for (int i = 0; i < n; i++) {
+    if (data[i] >= NUM_CARD_KEYS) return false;
+  }
+  cards.resize (n);
+  for (int i = 0; i < n; i++) {
+    int key = data[i];
+    cards[i].suit = Suit (key / 13);
+    cards[i].rank = Rank (key % 13 + 1);
+  }
+  return true;
 }
 
 int Deck::find (const Card& card) const { //linear search
@@ -65,7 +105,15 @@ int Deck::findLowestCard (int low, int high) const
   return mindex;
 }
 
+// A deck only holds 52 different cards, however many decks are
+// mixed into it, so we can count them instead of comparing them:
+// O(n) instead of O(n^2).  See Ordering.h.
 void Deck::sort ()
+{
+  sort<SuitMajorAceLow> ();
+}
+
+void Deck::selectionSort ()
 {
   for (int i=0; i<cards.size(); i++) {
     int j = findLowestCard (i, cards.size()-1);
@@ -90,3 +138,11 @@ Deck Deck::subdeck (int low, int high) const {
   }
   return sub;
 }
+
+DeckView Deck::view () const {
+  return DeckView (cards.data(), cards.size());
+}
+
+DeckView Deck::view (int low, int high) const {
+  return DeckView (cards.data() + low, high-low+1);
+}
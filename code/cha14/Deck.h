@@ -2,9 +2,12 @@
 #define DECK_H
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include "Random.h"
 using namespace std;
 
 struct Card;
+struct DeckView;
 
 struct Deck {
   vector<Card> cards;
@@ -12,12 +15,41 @@ struct Deck {
   Deck ();
   Deck (int n);
   void print () const;
+  void printShort () const;
+  void encode (vector<unsigned char>& out) const;
+  bool decode (const unsigned char* data, int n);
   int find (const Card& card) const;
   void swapCards (int i, int j);
   void shuffle ();
+  template <class Rng> void shuffle (Rng& rng);
   int findLowestCard (int low, int high) const;
+  template <class Order> int findLowestCard (int low, int high) const;
   void sort ();
+  template <class Order> void sort ();
+  void selectionSort ();
+  template <class Less> void sort (Less isLess);
   Deck mergeSort(Deck deck) const;
   Deck subdeck (int low, int high) const;
+  DeckView view () const;
+  DeckView view (int low, int high) const;
 };
+
+// Fisher-Yates with a caller-supplied engine, so shuffles can run on
+// several threads at once and be replayed from a seed.
+template <class Rng>
+void Deck::shuffle (Rng& rng)
+{
+  int n = cards.size();
+  for (int i=0; i<n-1; i++) {
+    int j = randomInt (rng, i, n-1);
+    swapCards (i, j);
+  }
+}
+
+// For orderings other than the usual one: a stable comparison sort.
+template <class Less>
+void Deck::sort (Less isLess)
+{
+  std::stable_sort (cards.begin(), cards.end(), isLess);
+}
 #endif
@@ -0,0 +1,138 @@
+#include "DeckPool.h"
+#include <chrono>
+
+// capacity is rounded up to a power of two
+DeckPool::DeckPool (int capacity, int numWorkers, uint64_t seed)
+  : head (0), tail (0), running (true)
+{
+  size_t size = 2;
+  while (size < capacity) size *= 2;
+  slots = vector<Slot> (size);
+  mask = size - 1;
+  for (size_t i = 0; i < size; i++) {
+    slots[i].sequence.store (i, memory_order_relaxed);
+  }
+
+  // one stream per worker, 2^128 draws apart
+  Random rng (seed);
+  for (int i = 0; i < numWorkers; i++) {
+    workers.push_back (thread (&DeckPool::work, this, rng));
+    rng.jump ();
+  }
+}
+
+DeckPool::~DeckPool ()
+{
+  stop ();
+}
+
+void DeckPool::stop ()
+{
+  running.store (false);
+  for (int i = 0; i < workers.size(); i++) {
+    if (workers[i].joinable()) workers[i].join ();
+  }
+}
+
+// Swaps deck into a free slot; deck gets that slot's old cards back.
+// Returns false if the ring is full.
+bool DeckPool::tryPush (Deck& deck)
+{
+  size_t pos = tail.load (memory_order_relaxed);
+  for (;;) {
+    Slot& slot = slots[pos & mask];
+    size_t seq = slot.sequence.load (memory_order_acquire);
+    long diff = (long) seq - (long) pos;
+    if (diff == 0) {
+      if (tail.compare_exchange_weak (pos, pos + 1, memory_order_relaxed)) {
+        slot.deck.cards.swap (deck.cards);
+        slot.sequence.store (pos + 1, memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = tail.load (memory_order_relaxed);
+    }
+  }
+}
+
+// Swaps a ready deck into deck in constant time, handing our old cards
+// back to the pool for reuse.  Returns false if the ring is empty.
+bool DeckPool::tryPop (Deck& deck)
+{
+  size_t pos = head.load (memory_order_relaxed);
+  for (;;) {
+    Slot& slot = slots[pos & mask];
+    size_t seq = slot.sequence.load (memory_order_acquire);
+    long diff = (long) seq - (long) (pos + 1);
+    if (diff == 0) {
+      if (head.compare_exchange_weak (pos, pos + 1, memory_order_relaxed)) {
+        slot.deck.cards.swap (deck.cards);
+        slot.sequence.store (pos + mask + 1, memory_order_release);
+        myCounters ().consumed.fetch_add (1, memory_order_relaxed);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = head.load (memory_order_relaxed);
+    }
+  }
+}
+
+// Takes a deck from the pool, or shuffles one here if the workers have
+// fallen behind, so a game never waits on the pool.
+void DeckPool::take (Deck& deck, Random& rng)
+{
+  if (tryPop (deck)) return;
+  myCounters ().misses.fetch_add (1, memory_order_relaxed);
+  if (deck.cards.size() != 52) deck = Deck ();
+  deck.shuffle (rng);
+}
+
+// A worker shuffles a deck, then waits for room to put it in the ring,
+// backing off harder the longer the ring stays full.
+void DeckPool::work (Random rng)
+{
+  Counters& mine = myCounters ();
+  Deck deck;
+  while (running.load (memory_order_relaxed)) {
+    // the cards handed back by a consumer may be in any order and of
+    // any size, so start from a whole deck
+    if (deck.cards.size() != 52) deck = Deck ();
+    deck.shuffle (rng);
+
+    int spins = 0;
+    while (!tryPush (deck)) {
+      if (!running.load (memory_order_relaxed)) return;
+      mine.fullWaits.fetch_add (1, memory_order_relaxed);
+      if (++spins < 16) {
+        this_thread::yield ();
+      } else {
+        this_thread::sleep_for (chrono::microseconds (50));
+      }
+    }
+    mine.produced.fetch_add (1, memory_order_relaxed);
+  }
+}
+
+// each thread gets the next stripe the first time it counts anything
+DeckPool::Counters& DeckPool::myCounters ()
+{
+  static atomic<int> nextStripe (0);
+  static thread_local int stripe = nextStripe.fetch_add (1) % STRIPES;
+  return counters[stripe];
+}
+
+PoolStats DeckPool::stats () const
+{
+  PoolStats s = { 0, 0, 0, 0 };
+  for (int i = 0; i < STRIPES; i++) {
+    s.produced += counters[i].produced.load ();
+    s.consumed += counters[i].consumed.load ();
+    s.misses += counters[i].misses.load ();
+    s.fullWaits += counters[i].fullWaits.load ();
+  }
+  return s;
+}
@@ -0,0 +1,65 @@
+#ifndef DECKPOOL_H
+#define DECKPOOL_H
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+using namespace std;
+
+// Counters for one pool.  They are read while the pool is running, so
+// they are only approximately consistent with each other.
+struct PoolStats {
+  long produced;   // decks shuffled by the workers
+  long consumed;   // decks handed out ready-made
+  long misses;     // takes that found the pool empty
+  long fullWaits;  // times a worker found the pool full and backed off
+};
+
+// A bounded ring of freshly shuffled decks.  Worker threads keep it
+// full in the background and game threads take decks out of it.  The
+// ring is the lock-free bounded queue by Dmitry Vyukov: each slot has
+// a sequence number that tells producers and consumers whose turn it
+// is, so neither side ever takes a lock.  Decks are swapped in and out
+// of the slots, so once the pool is warm nothing is allocated.
+struct DeckPool {
+  struct Slot {
+    atomic<size_t> sequence;
+    Deck deck;
+  };
+
+  // The counters are spread over STRIPES cache lines and each thread
+  // counts on its own one, so they are not another line that every
+  // push and pop writes to; stats () adds the stripes up.
+  struct alignas (64) Counters {
+    atomic<long> produced, consumed, misses, fullWaits;
+    Counters () : produced (0), consumed (0), misses (0), fullWaits (0) {}
+  };
+  static const int STRIPES = 16;
+
+  vector<Slot> slots;
+  size_t mask;
+  // head and tail on lines of their own, so consumers moving head
+  // don't keep taking the line away from producers moving tail
+  alignas (64) atomic<size_t> head;    // next slot to take from
+  alignas (64) atomic<size_t> tail;    // next slot to fill
+  alignas (64) atomic<bool> running;
+  vector<thread> workers;
+  Counters counters[STRIPES];
+
+  DeckPool (int capacity, int numWorkers, uint64_t seed);
+  ~DeckPool ();
+
+  bool tryPush (Deck& deck);
+  bool tryPop (Deck& deck);
+  void take (Deck& deck, Random& rng);
+  void stop ();
+  PoolStats stats () const;
+  void work (Random rng);
+  Counters& myCounters ();
+
+  DeckPool (const DeckPool&) = delete;
+  void operator= (const DeckPool&) = delete;
+};
+#endif
@@ -0,0 +1,65 @@
+#include "DeckView.h"
+#include "Card.h"
+#include "Deck.h"
+
+DeckView::DeckView () {
+  cards = NULL;  size = 0;
+}
+
+DeckView::DeckView (const Card* first, int n) {
+  cards = first;  size = n;
+}
+
+void DeckView::print () const {
+  string text;
+  for (int i = 0; i < size; i++) {
+    cards[i].write (text);
+  }
+  cout.write (text.data(), text.size());
+}
+
+int DeckView::find (const Card& card) const { //linear search
+  for (int i = 0; i < size; i++) {
+    if (card.equals (cards[i])) return i;
+  }
+  return -1;
+}
+
+int DeckView::findLowestCard (int low, int high) const
+{
+  int mindex = low;
+
+  for (int i=low+1; i<=high; i++) {
+    if (cards[mindex].isGreater (cards[i])) {
+      mindex = i;
+    }
+  }
+  return mindex;
+}
+
+int DeckView::findBisect (const Card& card) const { //binary search
+  int low = 0, high = size-1;
+
+  while (low <= high) {
+    int mid = (high + low) / 2;
+    if (card.equals (cards[mid])) return mid;
+
+    if (cards[mid].isGreater (card)) {
+      high = mid-1;
+    } else {
+      low = mid+1;
+    }
+  }
+  return -1;
+}
+
+DeckView DeckView::subview (int low, int high) const {
+  return DeckView (cards + low, high-low+1);
+}
+
+// the only operation here that allocates
+Deck DeckView::toDeck () const {
+  Deck deck (0);
+  deck.cards.assign (cards, cards + size);
+  return deck;
+}
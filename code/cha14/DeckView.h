@@ -0,0 +1,27 @@
+#ifndef DECKVIEW_H
+#define DECKVIEW_H
+#include <iostream>
+#include <vector>
+using namespace std;
+
+struct Card;
+struct Deck;
+
+// A read-only window onto cards that live in some Deck.  Making one
+// copies two words and allocates nothing; the Deck has to outlive it
+// and must not be resized while it is in use.
+struct DeckView {
+  const Card* cards;
+  int size;
+
+  DeckView ();
+  DeckView (const Card* first, int n);
+
+  void print () const;
+  int find (const Card& card) const;
+  int findLowestCard (int low, int high) const;
+  int findBisect (const Card& card) const;
+  DeckView subview (int low, int high) const;
+  Deck toDeck () const;
+};
+#endif
@@ -0,0 +1,85 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+#include <algorithm>
+#include <vector>
+#include "Card.h"
+#include "Deck.h"
+using namespace std;
+
+// Ordering policies.  Each one maps a card to an integer from 0 to 51,
+// and one card comes before another when its key is smaller.  Because
+// the policy is a template argument, key() is inlined into the sorts
+// and searches and every comparison is a single integer compare.
+
+// ace (or any rank) as a number from 0 (lowest) to 12 (highest)
+inline int aceLow (Rank rank) { return rank - 1; }
+inline int aceHigh (Rank rank) { return (rank + 11) % 13; }
+
+// the order of Card::isGreater
+struct SuitMajorAceLow {
+  static int key (const Card& card) { return cardKey (card); }
+};
+
+struct SuitMajorAceHigh {
+  static int key (const Card& card) {
+    return card.suit * 13 + aceHigh (card.rank);
+  }
+};
+
+struct RankMajorAceLow {
+  static int key (const Card& card) {
+    return aceLow (card.rank) * 4 + card.suit;
+  }
+};
+
+struct RankMajorAceHigh {
+  static int key (const Card& card) {
+    return aceHigh (card.rank) * 4 + card.suit;
+  }
+};
+
+template <class Order>
+bool isLess (const Card& c1, const Card& c2)
+{
+  return Order::key (c1) < Order::key (c2);
+}
+
+template <class Order>
+int Deck::findLowestCard (int low, int high) const
+{
+  int mindex = low;
+  int minKey = Order::key (cards[low]);
+
+  for (int i=low+1; i<=high; i++) {
+    int key = Order::key (cards[i]);
+    mindex = (key < minKey) ? i : mindex;
+    minKey = (key < minKey) ? key : minKey;
+  }
+  return mindex;
+}
+
+// Every policy has only 52 keys, so this is the counting sort from
+// Deck::sort (), falling back to a comparison sort for cards it does
+// not recognize.
+template <class Order>
+void Deck::sort ()
+{
+  int start[NUM_CARD_KEYS+1] = { 0 };
+  for (int i=0; i<cards.size(); i++) {
+    if (!isValidCard (cards[i])) {
+      sort (isLess<Order>);
+      return;
+    }
+    start[Order::key (cards[i]) + 1]++;
+  }
+  for (int k=1; k<=NUM_CARD_KEYS; k++) {
+    start[k] += start[k-1];
+  }
+
+  vector<Card> sorted (cards.size());
+  for (int i=0; i<cards.size(); i++) {
+    sorted[start[Order::key (cards[i])]++] = cards[i];
+  }
+  cards.swap (sorted);
+}
+#endif
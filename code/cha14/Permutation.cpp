@@ -0,0 +1,158 @@
+#include "Permutation.h"
+#include "Card.h"
+#include "Deck.h"
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+// The rank is the Lehmer code of the deck read as a mixed-radix
+// number: digit i counts the unused cards with a smaller key than card
+// i, and has radix 52-i.  Unused cards are the bits of one 64-bit
+// mask, so each digit is one popcount.
+//
+// Most of the digits are combined in 64-bit arithmetic; only when the
+// radix product would overflow is the 256-bit number touched, so it
+// takes five multiplies by a word instead of 52.
+
+const int NUM_CARDS = 52;
+
+struct Chunks {
+  int first[NUM_CARDS+1];    // chunk c covers digits first[c] .. first[c+1]-1
+  uint64_t product[NUM_CARDS];
+  int count;
+
+  Chunks () {
+    count = 0;
+    int i = 0;
+    while (i < NUM_CARDS) {
+      first[count] = i;
+      uint64_t p = 1;
+      while (i < NUM_CARDS && p <= UINT64_MAX / (NUM_CARDS - i)) {
+        p *= NUM_CARDS - i;
+        i++;
+      }
+      product[count++] = p;
+    }
+    first[count] = NUM_CARDS;
+  }
+};
+
+static const Chunks CHUNKS;
+
+bool DeckRank::equals (const DeckRank& other) const {
+  for (int i = 0; i < 4; i++) {
+    if (words[i] != other.words[i]) return false;
+  }
+  return true;
+}
+
+// big = big * m + a
+static void multiplyAdd (uint64_t* big, uint64_t m, uint64_t a)
+{
+  unsigned __int128 carry = a;
+  for (int i = 0; i < 4; i++) {
+    unsigned __int128 t = (unsigned __int128) big[i] * m + carry;
+    big[i] = (uint64_t) t;
+    carry = t >> 64;
+  }
+}
+
+// big = big / d, returning the remainder.  Since rem < d the quotient
+// of each step fits in a word, so on x86-64 a single divq does it
+// instead of a call to the 128-bit division routine.
+static uint64_t divide (uint64_t* big, uint64_t d)
+{
+  uint64_t rem = 0;
+  for (int i = 3; i >= 0; i--) {
+#if defined(__x86_64__)
+    uint64_t quotient;
+    __asm__ ("divq %4"
+             : "=a" (quotient), "=d" (rem)
+             : "a" (big[i]), "d" (rem), "r" (d));
+    big[i] = quotient;
+#else
+    unsigned __int128 t = ((unsigned __int128) rem << 64) | big[i];
+    big[i] = (uint64_t) (t / d);
+    rem = (uint64_t) (t % d);
+#endif
+  }
+  return rem;
+}
+
+// the position of the nth set bit of mask
+static int selectBit (uint64_t mask, int n)
+{
+#ifdef __BMI2__
+  return __builtin_ctzll (_pdep_u64 (1ULL << n, mask));
+#else
+  for (int i = 0; i < n; i++) mask &= mask - 1;
+  return __builtin_ctzll (mask);
+#endif
+}
+
+// returns false unless the deck holds each of the 52 cards once
+bool rankDeck (const Deck& deck, DeckRank& rank)
+{
+  if (deck.cards.size() != NUM_CARDS) return false;
+  uint64_t unused = (1ULL << NUM_CARDS) - 1;
+  for (int i = 0; i < 4; i++) rank.words[i] = 0;
+
+  for (int c = 0; c < CHUNKS.count; c++) {
+    uint64_t small = 0;
+    for (int i = CHUNKS.first[c]; i < CHUNKS.first[c+1]; i++) {
+      const Card& card = deck.cards[i];
+      if (!isValidCard (card)) return false;
+      uint64_t bit = 1ULL << cardKey (card);
+      if (!(unused & bit)) return false;
+      small = small * (NUM_CARDS - i) + __builtin_popcountll (unused & (bit - 1));
+      unused &= ~bit;
+    }
+    multiplyAdd (rank.words, CHUNKS.product[c], small);
+  }
+  return true;
+}
+
+void unrankDeck (const DeckRank& rank, Deck& deck)
+{
+  uint64_t big[4];
+  for (int i = 0; i < 4; i++) big[i] = rank.words[i];
+
+  // peel the digits off from the least significant end
+  int digits[NUM_CARDS];
+  for (int c = CHUNKS.count - 1; c >= 0; c--) {
+    uint64_t small = divide (big, CHUNKS.product[c]);
+    for (int i = CHUNKS.first[c+1] - 1; i >= CHUNKS.first[c]; i--) {
+      digits[i] = small % (NUM_CARDS - i);
+      small /= NUM_CARDS - i;
+    }
+  }
+
+  deck.cards.resize (NUM_CARDS);
+  uint64_t unused = (1ULL << NUM_CARDS) - 1;
+  for (int i = 0; i < NUM_CARDS; i++) {
+    int key = selectBit (unused, digits[i]);
+    unused &= ~(1ULL << key);
+    deck.cards[i].suit = Suit (key / 13);
+    deck.cards[i].rank = Rank (key % 13 + 1);
+  }
+}
+
+bool rankDecks (const vector<Deck>& decks, vector<DeckRank>& ranks)
+{
+  ranks.resize (decks.size());
+  for (int i = 0; i < decks.size(); i++) {
+    if (!rankDeck (decks[i], ranks[i])) {
+      ranks.clear ();
+      return false;
+    }
+  }
+  return true;
+}
+
+void unrankDecks (const vector<DeckRank>& ranks, vector<Deck>& decks)
+{
+  decks.resize (ranks.size());
+  for (int i = 0; i < ranks.size(); i++) {
+    unrankDeck (ranks[i], decks[i]);
+  }
+}
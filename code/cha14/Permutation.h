@@ -0,0 +1,26 @@
+#ifndef PERMUTATION_H
+#define PERMUTATION_H
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+struct Deck;
+
+// The position of one ordering of a 52-card deck among all 52! of
+// them, as a 256-bit number (it needs 226 bits).  words[0] holds the
+// lowest 64 bits.  32 bytes instead of the 416 of 52 Cards.
+struct DeckRank {
+  uint64_t words[4];
+
+  bool equals (const DeckRank& other) const;
+};
+
+bool rankDeck (const Deck& deck, DeckRank& rank);
+void unrankDeck (const DeckRank& rank, Deck& deck);
+
+// for archiving many shuffles; ranks[i] is the rank of decks[i].  If
+// any deck is not a full 52-card deck the whole batch fails: ranks is
+// left empty and the result is false.
+bool rankDecks (const vector<Deck>& decks, vector<DeckRank>& ranks);
+void unrankDecks (const vector<DeckRank>& ranks, vector<Deck>& decks);
+#endif
@@ -0,0 +1,121 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <stdint.h>
+
+// Random number engines.  Each object has its own state, so every deck
+// or thread can own one, and the same seed always replays the same
+// sequence.  An engine only has to provide next32 () to be used with
+// randomBelow, randomInt and Deck::shuffle.
+
+// SplitMix64 is mostly used to turn one seed into the state of the
+// bigger engines.
+struct SplitMix64 {
+  uint64_t state;
+
+  SplitMix64 (uint64_t seed = 0) { state = seed; }
+
+  uint64_t next () {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  uint32_t next32 () { return (uint32_t) (next () >> 32); }
+};
+
+// xoshiro256** by Blackman and Vigna.
+struct Xoshiro256 {
+  uint64_t s[4];
+
+  Xoshiro256 (uint64_t seed = 0) {
+    SplitMix64 mixer (seed);
+    for (int i = 0; i < 4; i++) s[i] = mixer.next ();
+  }
+
+  static uint64_t rotl (uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t next () {
+    uint64_t result = rotl (s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl (s[3], 45);
+    return result;
+  }
+
+  uint32_t next32 () { return (uint32_t) (next () >> 32); }
+
+  // Advances the state by 2^128 steps.  Calling jump () on copies of
+  // one engine gives non-overlapping streams, one per thread.
+  void jump () {
+    static const uint64_t JUMP[] = {
+      0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+      0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    uint64_t t[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+      for (int b = 0; b < 64; b++) {
+        if (JUMP[i] & (1ULL << b)) {
+          for (int k = 0; k < 4; k++) t[k] ^= s[k];
+        }
+        next ();
+      }
+    }
+    for (int k = 0; k < 4; k++) s[k] = t[k];
+  }
+};
+
+// PCG32 (XSH-RR) by O'Neill.  The stream number picks one of 2^63
+// independent sequences for the same seed.
+struct Pcg32 {
+  uint64_t state, inc;
+
+  Pcg32 (uint64_t seed = 0, uint64_t stream = 0) {
+    state = 0;
+    inc = (stream << 1) | 1;
+    next32 ();
+    state += seed;
+    next32 ();
+  }
+
+  uint32_t next32 () {
+    uint64_t old = state;
+    state = old * 6364136223846793005ULL + inc;
+    uint32_t xorshifted = (uint32_t) (((old >> 18) ^ old) >> 27);
+    int rot = (int) (old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+  }
+};
+
+// the default engine
+typedef Xoshiro256 Random;
+
+// An unbiased integer in [0, n), using Lemire's nearly divisionless
+// method: one multiply, and a division only on the rare rejection path.
+template <class Rng>
+uint32_t randomBelow (Rng& rng, uint32_t n)
+{
+  uint64_t m = (uint64_t) rng.next32 () * n;
+  uint32_t low = (uint32_t) m;
+  if (low < n) {
+    uint32_t threshold = (0u - n) % n;
+    while (low < threshold) {
+      m = (uint64_t) rng.next32 () * n;
+      low = (uint32_t) m;
+    }
+  }
+  return (uint32_t) (m >> 32);
+}
+
+// a random integer between low and high (inclusive)
+template <class Rng>
+int randomInt (Rng& rng, int low, int high)
+{
+  return low + (int) randomBelow (rng, (uint32_t) (high - low + 1));
+}
+#endif
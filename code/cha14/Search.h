@@ -0,0 +1,149 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+#include <vector>
+#include "Card.h"
+#include "DeckView.h"
+#include "Ordering.h"
+using namespace std;
+
+// Branchless searches over sorted keys.  The loops only ever move a
+// pointer forward by a computed amount, which the compiler turns into a
+// conditional move, so there is no branch to mispredict.
+
+// index of the first key that is not less than key (n if there is none)
+template <class T>
+int lowerBound (const T* keys, int n, T key)
+{
+  if (n == 0) return 0;
+  const T* base = keys;
+  int len = n;
+  while (len > 1) {
+    int half = len / 2;
+    base = (base[half] < key) ? base + half : base;
+    len -= half;
+  }
+  return (base - keys) + (*base < key);
+}
+
+// Looks up many keys at once.  Groups of BATCH lookups walk down the
+// array in lockstep, so their cache misses overlap instead of waiting
+// on each other one at a time.
+template <class T>
+void lowerBoundBatch (const T* keys, int n, const T* queries, int m,
+                      int* results)
+{
+  const int BATCH = 16;
+  const T* base[BATCH];
+  for (int q = 0; q < m; q += BATCH) {
+    int count = (m - q < BATCH) ? m - q : BATCH;
+    if (n == 0) {
+      for (int i = 0; i < count; i++) results[q+i] = 0;
+      continue;
+    }
+    for (int i = 0; i < count; i++) base[i] = keys;
+
+    int len = n;
+    while (len > 1) {
+      int half = len / 2;
+      for (int i = 0; i < count; i++) {
+        base[i] = (base[i][half] < queries[q+i]) ? base[i] + half : base[i];
+        __builtin_prefetch (base[i] + (len - half) / 2);
+      }
+      len -= half;
+    }
+    for (int i = 0; i < count; i++) {
+      results[q+i] = (base[i] - keys) + (*base[i] < queries[q+i]);
+    }
+  }
+}
+
+// The same keys stored in Eytzinger (breadth-first) order: the root is
+// at 1 and the children of k are at 2k and 2k+1.  The top levels of
+// the tree share a few cache lines, and the 16 descendants four levels
+// down are contiguous, so they can be prefetched with one instruction.
+template <class T>
+struct EytzingerIndex {
+  vector<T> tree;       // tree[1..n]
+  vector<int> rank;     // rank[k] is the sorted index of tree[k]
+  int n;
+
+  EytzingerIndex (const T* sorted, int size) {
+    n = size;
+    tree.resize (n + 1);
+    rank.resize (n + 2);
+    int i = 0;
+    build (sorted, i, 1);
+    rank[0] = n;   // "past the end"
+  }
+
+  void build (const T* sorted, int& i, int k) {
+    if (k > n) return;
+    build (sorted, i, 2*k);
+    tree[k] = sorted[i];
+    rank[k] = i++;
+    build (sorted, i, 2*k+1);
+  }
+
+  // the sorted index of the first key not less than key
+  int lowerBound (T key) const {
+    int k = 1;
+    while (k <= n) {
+      __builtin_prefetch (tree.data() + 16*k);
+      k = 2*k + (tree[k] < key);
+    }
+    // undo the final run of right turns
+    k >>= __builtin_ffs (~k);
+    return rank[k];
+  }
+
+  void lowerBoundBatch (const T* queries, int m, int* results) const {
+    const int BATCH = 16;
+    int k[BATCH];
+    // every path is at least this deep, so no bounds checks are needed
+    int levels = 0;
+    while ((2 << levels) - 1 <= n) levels++;
+
+    for (int q = 0; q < m; q += BATCH) {
+      int count = (m - q < BATCH) ? m - q : BATCH;
+      for (int i = 0; i < count; i++) k[i] = 1;
+      for (int level = 0; level < levels; level++) {
+        for (int i = 0; i < count; i++) {
+          __builtin_prefetch (tree.data() + 16*k[i]);
+          k[i] = 2*k[i] + (tree[k[i]] < queries[q+i]);
+        }
+      }
+      for (int i = 0; i < count; i++) {
+        int j = k[i];
+        if (j <= n) j = 2*j + (tree[j] < queries[q+i]);
+        j >>= __builtin_ffs (~j);
+        results[q+i] = rank[j];
+      }
+    }
+  }
+};
+
+// Binary search for a card in a hand or deck sorted by Order, without
+// recursion or branches.  Returns -1 if the card is not there.
+template <class Order>
+int findBisect (const Card& card, const DeckView& view)
+{
+  if (view.size == 0) return -1;
+  int key = Order::key (card);
+  const Card* base = view.cards;
+  int len = view.size;
+  while (len > 1) {
+    int half = len / 2;
+    base = (Order::key (base[half]) < key) ? base + half : base;
+    len -= half;
+  }
+  base += (Order::key (*base) < key);
+  int index = base - view.cards;
+  if (index < view.size && card.equals (*base)) return index;
+  return -1;
+}
+
+inline int findBisect (const Card& card, const DeckView& view)
+{
+  return findBisect<SuitMajorAceLow> (card, view);
+}
+#endif
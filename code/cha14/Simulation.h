@@ -0,0 +1,68 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+
+// Trials are handed out in fixed-size blocks, and every block gets its
+// own generator seeded from (seed, block number).  That way the same
+// trials see the same shuffles no matter how many threads run them.
+const long TRIALS_PER_BLOCK = 4096;
+
+inline Random blockRandom (uint64_t seed, long block)
+{
+  SplitMix64 mixer (seed ^ ((uint64_t) block * 0xD1B54A32D192ED03ULL));
+  return Random (mixer.next ());
+}
+
+// Runs numTrials calls of trial (deck, rng, result) spread over
+// numThreads workers.  Each worker owns one Deck that it reshuffles in
+// place and one Result; the per-thread results are merged at the end,
+// so Result::merge should not care about the order it is called in.
+template <class Result, class Trial>
+Result simulate (long numTrials, int numThreads, uint64_t seed, Trial trial)
+{
+  if (numThreads < 1) numThreads = 1;
+  long numBlocks = (numTrials + TRIALS_PER_BLOCK - 1) / TRIALS_PER_BLOCK;
+  std::atomic<long> nextBlock (0);
+  vector<Result> results (numThreads);
+
+  auto worker = [&] (int id) {
+    Deck fresh;
+    Deck deck;
+    Result& result = results[id];
+    for (;;) {
+      long block = nextBlock.fetch_add (1);
+      if (block >= numBlocks) break;
+
+      // start every block from the same order, reusing the buffer
+      deck.cards = fresh.cards;
+      Random rng = blockRandom (seed, block);
+      long first = block * TRIALS_PER_BLOCK;
+      long last = first + TRIALS_PER_BLOCK;
+      if (last > numTrials) last = numTrials;
+      for (long t = first; t < last; t++) {
+        trial (deck, rng, result);
+      }
+    }
+  };
+
+  vector<std::thread> threads;
+  for (int i = 1; i < numThreads; i++) {
+    threads.push_back (std::thread (worker, i));
+  }
+  worker (0);
+  for (int i = 0; i < threads.size(); i++) {
+    threads[i].join ();
+  }
+
+  Result total = results[0];
+  for (int i = 1; i < numThreads; i++) {
+    total.merge (results[i]);
+  }
+  return total;
+}
+#endif
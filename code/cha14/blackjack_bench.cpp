@@ -0,0 +1,47 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+#include "Blackjack.h"
+
+// Solves every starting hand for full shoes of 1 to 8 decks and shows
+// a few of the answers.
+
+const char* KIND_NAMES[NUM_KINDS] = {
+  "A", "2", "3", "4", "5", "6", "7", "8", "9", "T"
+};
+
+const HandEV& findHand (const vector<HandEV>& hands, int c1, int c2, int up)
+{
+  for (int i = 0; i < hands.size(); i++) {
+    const HandEV& hand = hands[i];
+    if (hand.card1 == c1 && hand.card2 == c2 && hand.upcard == up) {
+      return hand;
+    }
+  }
+  return hands[0];
+}
+
+int main (int argc, char* argv[])
+{
+  int numThreads = thread::hardware_concurrency ();
+  if (argc > 1) numThreads = atoi (argv[1]);
+  if (numThreads < 1) numThreads = 1;
+
+  cout << "decks\tseconds\thands/s\t6T v T: stand\thit\tAA v 6: split" << endl;
+  for (int decks = 1; decks <= 8; decks++) {
+    auto start = chrono::steady_clock::now ();
+    vector<HandEV> hands = solveStartingHands (Shoe (decks), numThreads);
+    chrono::duration<double> t = chrono::steady_clock::now () - start;
+
+    const HandEV& sixteen = findHand (hands, 5, 9, 9);
+    const HandEV& aces = findHand (hands, 0, 0, 5);
+    cout << decks << "\t" << t.count () << "\t"
+         << (long) (hands.size() / t.count ()) << "\t"
+         << KIND_NAMES[sixteen.card1] << KIND_NAMES[sixteen.card2] << " v "
+         << KIND_NAMES[sixteen.upcard] << ": " << sixteen.stand << "\t"
+         << sixteen.hit << "\t" << aces.split << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "DeckView.h"
+#include "Random.h"
+
+// Deal 10 five-card hands per shuffle, once with subdeck (a new Deck
+// per hand) and once with view (no allocation), and look at the
+// lowest card of each hand so the work is not optimized away.
+
+const int HANDS = 10;
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+int main (int argc, char* argv[])
+{
+  long numShuffles = 1000000;
+  if (argc > 1) numShuffles = atol (argv[1]);
+
+  Deck deck;
+  Random rng (17);
+  long checksum = 0;
+  auto start = chrono::steady_clock::now ();
+  for (long s = 0; s < numShuffles; s++) {
+    deck.shuffle (rng);
+    for (int h = 0; h < HANDS; h++) {
+      Deck hand = deck.subdeck (h*5, h*5+4);
+      checksum += hand.findLowestCard (0, 4);
+    }
+  }
+  double t = seconds (start);
+  cout << "subdeck\t" << (long) (numShuffles / t) << " shuffles/s\t"
+       << (long) (numShuffles * HANDS / t) << " hands/s\t(checksum "
+       << checksum << ")" << endl;
+
+  deck = Deck ();
+  rng = Random (17);
+  checksum = 0;
+  start = chrono::steady_clock::now ();
+  for (long s = 0; s < numShuffles; s++) {
+    deck.shuffle (rng);
+    for (int h = 0; h < HANDS; h++) {
+      DeckView hand = deck.view (h*5, h*5+4);
+      checksum += hand.findLowestCard (0, 4);
+    }
+  }
+  t = seconds (start);
+  cout << "view\t" << (long) (numShuffles / t) << " shuffles/s\t"
+       << (long) (numShuffles * HANDS / t) << " hands/s\t(checksum "
+       << checksum << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+
+// Cards per second for the long and short text forms and the binary
+// encoding, in both directions.
+
+const int NUM_DECKS = 100000;
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void report (const char* name, long cards, double t)
+{
+  cout << "  " << name << "\t" << (long) (cards / t) << " cards/s" << endl;
+}
+
+// the old Card::print, writing to a stream
+void printOld (const Card& card, ostream& out)
+{
+  vector<string> suits (4, "narf");
+  suits[0] = "Clubs";
+  suits[1] = "Diamonds";
+  suits[2] = "Hearts";
+  suits[3] = "Spades";
+
+  vector<string> ranks (14, "narf");
+  ranks[1] = "Ace";
+  ranks[2] = "2";
+  ranks[3] = "3";
+  ranks[4] = "4";
+  ranks[5] = "5";
+  ranks[6] = "6";
+  ranks[7] = "7";
+  ranks[8] = "8";
+  ranks[9] = "9";
+  ranks[10] = "10";
+  ranks[11] = "Jack";
+  ranks[12] = "Queen";
+  ranks[13] = "King";
+
+  out << ranks[card.rank] << " of " << suits[card.suit] << endl;
+}
+
+int main ()
+{
+  Random rng (17);
+  Deck deck;
+  deck.shuffle (rng);
+  long numCards = (long) NUM_DECKS * 52;
+
+  cout << "formatting:" << endl;
+  ostringstream stream;
+  auto start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    for (int i = 0; i < 52; i++) printOld (deck.cards[i], stream);
+  }
+  report ("old print", numCards, seconds (start));
+
+  string text;
+  start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    text.clear ();
+    for (int i = 0; i < 52; i++) deck.cards[i].write (text);
+  }
+  report ("write", numCards, seconds (start));
+
+  string shortText (52 * 2, ' ');
+  start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    for (int i = 0; i < 52; i++) deck.cards[i].writeShort (&shortText[i*2]);
+  }
+  report ("short", numCards, seconds (start));
+
+  vector<unsigned char> bytes;
+  start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    bytes.clear ();
+    deck.encode (bytes);
+  }
+  report ("binary", numCards, seconds (start));
+
+  cout << "parsing:" << endl;
+  Deck parsed (52);
+  bool ok = true;
+  start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    for (int i = 0; i < 52; i++) {
+      ok &= parseCard (&shortText[i*2], parsed.cards[i]);
+    }
+  }
+  report ("short", numCards, seconds (start));
+
+  start = chrono::steady_clock::now ();
+  for (int d = 0; d < NUM_DECKS; d++) {
+    ok &= parsed.decode (bytes.data(), bytes.size());
+  }
+  report ("binary", numCards, seconds (start));
+
+  for (int i = 0; i < 52; i++) {
+    if (!parsed.cards[i].equals (deck.cards[i])) ok = false;
+  }
+  cout << "round trip: " << (ok ? "ok" : "FAILED") << endl;
+  return 0;
+}
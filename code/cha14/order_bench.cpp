@@ -0,0 +1,91 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "DeckView.h"
+#include "Ordering.h"
+#include "Random.h"
+#include "Search.h"
+
+// Card::isGreater through an out-of-line call against the inlined
+// integer keys of an ordering policy.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void report (const char* name, long ops, double t, long checksum)
+{
+  cout << "  " << name << "\t" << (long) (ops / t) << " /s"
+       << "\t(checksum " << checksum << ")" << endl;
+}
+
+template <class Order>
+void timeOrder (const char* name, const Deck& shoe)
+{
+  Deck deck = shoe;
+  auto start = chrono::steady_clock::now ();
+  deck.sort<Order> ();
+  double t = seconds (start);
+  cout << "  " << name << "\t" << (long) (deck.cards.size() / t)
+       << " cards/s, first card: ";
+  deck.cards[0].print ();
+}
+
+int main ()
+{
+  Random rng (17);
+  Deck shoe (0);
+  Deck one;
+  for (int i = 0; i < 200; i++) {
+    shoe.cards.insert (shoe.cards.end(), one.cards.begin(), one.cards.end());
+  }
+  shoe.shuffle (rng);
+  int n = shoe.cards.size();
+
+  cout << "findLowestCard over " << n << " cards (scans/s):" << endl;
+  const int SCANS = 2000;
+  long checksum = 0;
+  auto start = chrono::steady_clock::now ();
+  for (int i = 0; i < SCANS; i++) {
+    checksum += shoe.findLowestCard (i, n-1);
+  }
+  report ("isGreater", SCANS, seconds (start), checksum);
+
+  checksum = 0;
+  start = chrono::steady_clock::now ();
+  for (int i = 0; i < SCANS; i++) {
+    checksum += shoe.findLowestCard<SuitMajorAceLow> (i, n-1);
+  }
+  report ("policy", SCANS, seconds (start), checksum);
+
+  cout << "bisect search in a sorted deck (lookups/s):" << endl;
+  Deck deck;
+  deck.sort ();
+  const long LOOKUPS = 20000000;
+  checksum = 0;
+  DeckView view = deck.view ();
+  start = chrono::steady_clock::now ();
+  for (long i = 0; i < LOOKUPS; i++) {
+    checksum += view.findBisect (deck.cards[i % 52]);
+  }
+  report ("isGreater", LOOKUPS, seconds (start), checksum);
+
+  checksum = 0;
+  start = chrono::steady_clock::now ();
+  for (long i = 0; i < LOOKUPS; i++) {
+    checksum += findBisect<SuitMajorAceLow> (deck.cards[i % 52], view);
+  }
+  report ("policy", LOOKUPS, seconds (start), checksum);
+
+  cout << "sorting the shoe with each policy:" << endl;
+  timeOrder<SuitMajorAceLow> ("suit, ace low", shoe);
+  timeOrder<SuitMajorAceHigh> ("suit, ace high", shoe);
+  timeOrder<RankMajorAceLow> ("rank, ace low", shoe);
+  timeOrder<RankMajorAceHigh> ("rank, ace high", shoe);
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Permutation.h"
+#include "Random.h"
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+int main (int argc, char* argv[])
+{
+  int numDecks = 1000000;
+  if (argc > 1) numDecks = atoi (argv[1]);
+
+  Random rng (17);
+  vector<Deck> decks (numDecks);
+  for (int i = 0; i < numDecks; i++) {
+    decks[i].shuffle (rng);
+  }
+  cout << "storage per shuffle: " << sizeof (Card) * 52 << " bytes as Cards, "
+       << sizeof (DeckRank) << " bytes ranked" << endl;
+
+  vector<DeckRank> ranks;
+  auto start = chrono::steady_clock::now ();
+  bool ranked = rankDecks (decks, ranks);
+  int count = ranks.size ();
+  double t = seconds (start);
+  cout << "encode\t" << (long) (count / t) << " decks/s" << endl;
+
+  vector<Deck> restored;
+  start = chrono::steady_clock::now ();
+  unrankDecks (ranks, restored);
+  t = seconds (start);
+  cout << "decode\t" << (long) (count / t) << " decks/s" << endl;
+
+  bool ok = ranked && count == numDecks;
+  for (int i = 0; i < numDecks && ok; i++) {
+    for (int j = 0; j < 52; j++) {
+      if (!restored[i].cards[j].equals (decks[i].cards[j])) ok = false;
+    }
+  }
+  cout << "round trip: " << (ok ? "ok" : "FAILED") << endl;
+
+  // the sorted deck is permutation 0, the reversed one is 52! - 1
+  Deck sorted;
+  DeckRank first;
+  rankDeck (sorted, first);
+  cout << "rank of a new deck: " << first.words[0] << endl;
+  return 0;
+}
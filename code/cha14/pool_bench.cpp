@@ -0,0 +1,87 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "DeckPool.h"
+#include "Random.h"
+
+// Simulated tables: each game thread serves its share of the tables in
+// turn, starting a hand (getting a shuffled deck) and then playing it
+// for a while.  We time only the hand start.
+
+const int NUM_TABLES = 10000;
+const int HANDS_PER_TABLE = 20;
+const int GAME_THREADS = 4;
+const int PLAY_MICROSECONDS = 2;
+
+typedef chrono::steady_clock Clock;
+
+void play (const Deck& deck, long& checksum)
+{
+  Clock::time_point end = Clock::now () + chrono::microseconds (PLAY_MICROSECONDS);
+  while (Clock::now () < end) {}
+  checksum += deck.cards[0].rank;
+}
+
+void serveTables (int id, DeckPool* pool, vector<double>& latencies)
+{
+  Random rng (1000 + id);
+  Deck deck;
+  long checksum = 0;
+  for (int hand = 0; hand < HANDS_PER_TABLE; hand++) {
+    for (int table = id; table < NUM_TABLES; table += GAME_THREADS) {
+      Clock::time_point start = Clock::now ();
+      if (pool) {
+        pool->take (deck, rng);
+      } else {
+        deck.shuffle (rng);
+      }
+      chrono::duration<double, micro> waited = Clock::now () - start;
+      latencies.push_back (waited.count ());
+      play (deck, checksum);
+    }
+  }
+}
+
+void run (const char* name, DeckPool* pool)
+{
+  vector<vector<double> > latencies (GAME_THREADS);
+  vector<thread> threads;
+  for (int i = 0; i < GAME_THREADS; i++) {
+    threads.push_back (thread (serveTables, i, pool, ref (latencies[i])));
+  }
+  for (int i = 0; i < GAME_THREADS; i++) threads[i].join ();
+
+  vector<double> all;
+  for (int i = 0; i < GAME_THREADS; i++) {
+    all.insert (all.end(), latencies[i].begin(), latencies[i].end());
+  }
+  sort (all.begin(), all.end());
+  int n = all.size();
+  cout << name << "\tp50 " << all[n/2] << " us\tp99 " << all[n*99/100]
+       << " us\tp99.9 " << all[n*999/1000] << " us" << endl;
+}
+
+int main (int argc, char* argv[])
+{
+  int numWorkers = 2;
+  if (argc > 1) numWorkers = atoi (argv[1]);
+
+  cout << NUM_TABLES << " tables, " << GAME_THREADS << " game threads, "
+       << "hand-start latency:" << endl;
+  run ("shuffle", NULL);
+
+  DeckPool pool (1024, numWorkers, 17);
+  this_thread::sleep_for (chrono::milliseconds (100));   // let it fill
+  run ("pool", &pool);
+  pool.stop ();
+
+  PoolStats s = pool.stats ();
+  cout << "pool: produced " << s.produced << ", consumed " << s.consumed
+       << ", misses " << s.misses << ", full waits " << s.fullWaits << endl;
+  return 0;
+}
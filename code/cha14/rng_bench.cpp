@@ -0,0 +1,118 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+
+const long NUM_DRAWS = 50000000;
+const long NUM_SHUFFLES = 1000000;
+
+// the old way: modulo reduction of one global generator
+struct ModuloRand {
+  uint32_t below (uint32_t n) { return rand () % n; }
+};
+
+template <class Rng>
+struct Lemire {
+  Rng rng;
+  Lemire (uint64_t seed) : rng (seed) {}
+  uint32_t below (uint32_t n) { return randomBelow (rng, n); }
+};
+
+// an engine handing out modulo-reduced draws, to see the bias
+template <class Rng>
+struct Modulo {
+  Rng rng;
+  Modulo (uint64_t seed) : rng (seed) {}
+  uint32_t below (uint32_t n) { return rng.next32 () % n; }
+};
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+template <class Sampler>
+void timeDraws (const char* name, Sampler sampler)
+{
+  auto start = chrono::steady_clock::now ();
+  uint32_t sum = 0;
+  for (long i = 0; i < NUM_DRAWS; i++) {
+    sum += sampler.below (52);
+  }
+  double t = seconds (start);
+  cout << name << "\t" << (long) (NUM_DRAWS / t) << " draws/s"
+       << "\t(checksum " << sum << ")" << endl;
+}
+
+// With n = 3 * 2^30, a plain modulo of a 32-bit draw lands in the
+// bottom third twice as often, so "below n/2" comes up 62.5% of the
+// time instead of 50%.
+template <class Sampler>
+void checkBias (const char* name, Sampler sampler)
+{
+  uint32_t n = 3u << 30;
+  long hits = 0, draws = 4000000;
+  for (long i = 0; i < draws; i++) {
+    if (sampler.below (n) < n / 2) hits++;
+  }
+  cout << name << "\tP(x < n/2) = " << (double) hits / draws
+       << " (unbiased: 0.5)" << endl;
+}
+
+template <class Rng>
+void timeShuffles (const char* name, Rng rng)
+{
+  Deck deck;
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < NUM_SHUFFLES; i++) {
+    deck.shuffle (rng);
+  }
+  double t = seconds (start);
+  cout << name << "\t" << (long) (NUM_SHUFFLES / t) << " shuffles/s" << endl;
+}
+
+int main ()
+{
+  cout << "Range sampling speed:" << endl;
+  timeDraws ("rand() %", ModuloRand ());
+  timeDraws ("xoshiro", Lemire<Xoshiro256> (17));
+  timeDraws ("pcg32", Lemire<Pcg32> (17));
+
+  cout << "\nRange sampling bias:" << endl;
+  checkBias ("xoshiro %", Modulo<Xoshiro256> (17));
+  checkBias ("xoshiro", Lemire<Xoshiro256> (17));
+  checkBias ("pcg32", Lemire<Pcg32> (17));
+
+  cout << "\nShuffle speed:" << endl;
+  Deck deck;
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < NUM_SHUFFLES; i++) {
+    deck.shuffle ();
+  }
+  cout << "rand()\t" << (long) (NUM_SHUFFLES / seconds (start))
+       << " shuffles/s" << endl;
+  timeShuffles ("xoshiro", Xoshiro256 (17));
+  timeShuffles ("pcg32", Pcg32 (17));
+
+  // the same seed replays the same shuffle
+  Deck d1, d2;
+  Xoshiro256 r1 (99), r2 (99);
+  d1.shuffle (r1);
+  d2.shuffle (r2);
+  bool same = true;
+  for (int i = 0; i < 52; i++) {
+    if (!d1.cards[i].equals (d2.cards[i])) same = false;
+  }
+  cout << "\nReplay from seed: " << (same ? "identical" : "DIFFERENT") << endl;
+
+  // jumped copies are independent streams
+  Xoshiro256 a (5), b (5);
+  b.jump ();
+  cout << "Jumped stream differs: " << (a.next () != b.next () ? "yes" : "NO")
+       << endl;
+  return 0;
+}
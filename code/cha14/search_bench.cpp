@@ -0,0 +1,138 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "DeckView.h"
+#include "Random.h"
+#include "Search.h"
+
+// the recursive search from main.cpp, without the trace output
+int findBisectRecursive (const int* keys, int key, int low, int high)
+{
+  if (high < low) return -1;
+  int mid = (high + low) / 2;
+  if (keys[mid] == key) return mid;
+  if (keys[mid] > key) {
+    return findBisectRecursive (keys, key, low, mid-1);
+  } else {
+    return findBisectRecursive (keys, key, mid+1, high);
+  }
+}
+
+int findBisectRecursive (const Card& card, const Deck& deck, int low, int high)
+{
+  if (high < low) return -1;
+  int mid = (high + low) / 2;
+  if (card.equals (deck.cards[mid])) return mid;
+  if (deck.cards[mid].isGreater (card)) {
+    return findBisectRecursive (card, deck, low, mid-1);
+  } else {
+    return findBisectRecursive (card, deck, mid+1, high);
+  }
+}
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void report (const char* name, long lookups, double t, long checksum)
+{
+  cout << "  " << name << "\t" << (long) (lookups / t) << " lookups/s"
+       << "\t(checksum " << checksum << ")" << endl;
+}
+
+void benchCards (long lookups)
+{
+  Deck deck;
+  deck.sort ();
+  Random rng (17);
+  vector<Card> queries (4096);
+  for (int i = 0; i < queries.size(); i++) {
+    queries[i] = deck.cards[randomBelow (rng, 52)];
+  }
+
+  cout << "52 cards:" << endl;
+  long checksum = 0;
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < lookups; i++) {
+    checksum += findBisectRecursive (queries[i & 4095], deck, 0, 51);
+  }
+  report ("recursive", lookups, seconds (start), checksum);
+
+  checksum = 0;
+  DeckView view = deck.view ();
+  start = chrono::steady_clock::now ();
+  for (long i = 0; i < lookups; i++) {
+    checksum += findBisect (queries[i & 4095], view);
+  }
+  report ("branchless", lookups, seconds (start), checksum);
+}
+
+void benchKeys (int n, long lookups)
+{
+  // even keys, so half of the random queries are misses
+  vector<int> keys (n);
+  for (int i = 0; i < n; i++) keys[i] = 2*i;
+  Random rng (17);
+  vector<int> queries (lookups);
+  for (long i = 0; i < lookups; i++) {
+    queries[i] = randomBelow (rng, 2*n);
+  }
+  vector<int> results (lookups);
+
+  cout << n << " keys:" << endl;
+  long checksum = 0;
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < lookups; i++) {
+    checksum += findBisectRecursive (keys.data(), queries[i], 0, n-1);
+  }
+  report ("recursive", lookups, seconds (start), checksum);
+
+  checksum = 0;
+  start = chrono::steady_clock::now ();
+  for (long i = 0; i < lookups; i++) {
+    checksum += lowerBound (keys.data(), n, queries[i]);
+  }
+  report ("branchless", lookups, seconds (start), checksum);
+
+  start = chrono::steady_clock::now ();
+  lowerBoundBatch (keys.data(), n, queries.data(), lookups, results.data());
+  double t = seconds (start);
+  checksum = 0;
+  for (long i = 0; i < lookups; i++) checksum += results[i];
+  report ("batched", lookups, t, checksum);
+
+  EytzingerIndex<int> index (keys.data(), n);
+  checksum = 0;
+  start = chrono::steady_clock::now ();
+  for (long i = 0; i < lookups; i++) {
+    checksum += index.lowerBound (queries[i]);
+  }
+  report ("eytzinger", lookups, seconds (start), checksum);
+
+  start = chrono::steady_clock::now ();
+  index.lowerBoundBatch (queries.data(), lookups, results.data());
+  t = seconds (start);
+  checksum = 0;
+  for (long i = 0; i < lookups; i++) checksum += results[i];
+  report ("eytz batch", lookups, t, checksum);
+}
+
+// The recursive search returns the index of a hit and -1 for a miss,
+// while the others return a lower bound, so only the last four
+// checksums in each table should agree.
+int main (int argc, char* argv[])
+{
+  int largest = 1000000;
+  if (argc > 1) largest = atoi (argv[1]);   // e.g. 100000000
+
+  benchCards (20000000);
+  for (long n = 1000000; n <= largest; n *= 100) {
+    benchKeys (n, 5000000);
+  }
+  return 0;
+}
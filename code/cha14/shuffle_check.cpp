@@ -0,0 +1,134 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+
+// Checks that shuffles are fast and still fair.  Every shuffle starts
+// from a new deck, and we count how often each card ends up in each
+// position.  For a fair shuffle all 52 x 52 counts should be about the
+// same, which a chi-square test measures.  Known-biased shuffles are
+// run too, to make sure the test can tell.
+//
+// Exits with 1 if a shuffle that should be fair fails, or a biased one
+// passes; "make check" runs it.
+
+const int N = 52;
+const double FAIL_P = 1e-4;
+
+// swaps each card with any card, not just the ones after it: n^n ways
+// to make n! orderings, so some come up more often
+template <class Rng>
+void naiveShuffle (Deck& deck, Rng& rng)
+{
+  for (int i = 0; i < N; i++) {
+    deck.swapCards (i, randomInt (rng, 0, N-1));
+  }
+}
+
+// never leaves a card where it is (Sattolo's algorithm), so it only
+// makes cyclic permutations
+template <class Rng>
+void offByOneShuffle (Deck& deck, Rng& rng)
+{
+  for (int i = 0; i < N-1; i++) {
+    deck.swapCards (i, randomInt (rng, i+1, N-1));
+  }
+}
+
+// the p-value of a chi-square statistic, by the Wilson-Hilferty
+// normal approximation (plenty accurate with 2601 degrees of freedom)
+double chiSquarePValue (double x, double df)
+{
+  double z = (pow (x / df, 1.0/3) - (1 - 2 / (9*df))) / sqrt (2 / (9*df));
+  return 0.5 * erfc (z / sqrt (2.0));
+}
+
+struct Result {
+  double shufflesPerSecond, chiSquare, pValue;
+};
+
+template <class Shuffle>
+Result check (long numShuffles, Shuffle shuffle)
+{
+  vector<long> counts (N * N, 0);
+  Deck fresh;
+  Deck deck;
+  auto start = chrono::steady_clock::now ();
+  for (long s = 0; s < numShuffles; s++) {
+    deck.cards = fresh.cards;
+    shuffle (deck);
+    for (int pos = 0; pos < N; pos++) {
+      counts[pos * N + cardKey (deck.cards[pos])]++;
+    }
+  }
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+
+  double expected = (double) numShuffles / N;
+  double x = 0;
+  for (int i = 0; i < N * N; i++) {
+    double d = counts[i] - expected;
+    x += d * d / expected;
+  }
+  // Each shuffle adds a permutation matrix, not 52 independent draws,
+  // so the counts in a row are not multinomial.  Worked out from the
+  // covariance of a random permutation matrix, the statistic is
+  // N/(N-1) times a chi-square with (N-1)^2 degrees of freedom.
+  x *= (double) (N-1) / N;
+  double df = (N-1) * (N-1);
+
+  Result result;
+  result.shufflesPerSecond = numShuffles / elapsed.count ();
+  result.chiSquare = x;
+  result.pValue = chiSquarePValue (x, df);
+  return result;
+}
+
+int failures = 0;
+
+template <class Shuffle>
+void report (const char* name, bool shouldPass, long numShuffles,
+             Shuffle shuffle)
+{
+  Result r = check (numShuffles, shuffle);
+  bool passed = r.pValue >= FAIL_P;
+  bool ok = (passed == shouldPass);
+  if (!ok) failures++;
+  cout << name << "\t" << (long) r.shufflesPerSecond << "/s\tchi2 "
+       << r.chiSquare << "\tp " << r.pValue << "\t"
+       << (passed ? "fair" : "biased") << (ok ? "" : "  <-- UNEXPECTED")
+       << endl;
+}
+
+int main (int argc, char* argv[])
+{
+  long numShuffles = 2000000;
+  if (argc > 1) numShuffles = atol (argv[1]);
+  cout << numShuffles << " shuffles each, 2601 degrees of freedom" << endl;
+
+  Xoshiro256 xoshiro (17);
+  Pcg32 pcg (17);
+  Xoshiro256 naiveRng (17);
+  Xoshiro256 offByOneRng (17);
+
+  report ("rand()", true, numShuffles,
+          [] (Deck& d) { d.shuffle (); });
+  report ("xoshiro", true, numShuffles,
+          [&] (Deck& d) { d.shuffle (xoshiro); });
+  report ("pcg32", true, numShuffles,
+          [&] (Deck& d) { d.shuffle (pcg); });
+  report ("naive", false, numShuffles,
+          [&] (Deck& d) { naiveShuffle (d, naiveRng); });
+  report ("sattolo", false, numShuffles,
+          [&] (Deck& d) { offByOneShuffle (d, offByOneRng); });
+
+  if (failures > 0) {
+    cout << failures << " unexpected result(s)" << endl;
+    return 1;
+  }
+  cout << "all as expected" << endl;
+  return 0;
+}
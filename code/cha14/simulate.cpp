@@ -0,0 +1,57 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+#include "Simulation.h"
+
+// how often does a five card hand hold a flush, or at least a pair?
+struct HandCounts {
+  long hands, flushes, pairs;
+
+  HandCounts () { hands = 0;  flushes = 0;  pairs = 0; }
+
+  void merge (const HandCounts& other) {
+    hands += other.hands;
+    flushes += other.flushes;
+    pairs += other.pairs;
+  }
+};
+
+void dealHand (Deck& deck, Random& rng, HandCounts& counts)
+{
+  deck.shuffle (rng);
+
+  int seen = 0;
+  bool flush = true, pair = false;
+  for (int i = 0; i < 5; i++) {
+    const Card& card = deck.cards[i];
+    if (card.suit != deck.cards[0].suit) flush = false;
+    if (seen & (1 << card.rank)) pair = true;
+    seen |= 1 << card.rank;
+  }
+  counts.hands++;
+  if (flush) counts.flushes++;
+  if (pair) counts.pairs++;
+}
+
+int main (int argc, char* argv[])
+{
+  long numTrials = 2000000;
+  if (argc > 1) numTrials = atol (argv[1]);
+  uint64_t seed = 17;
+
+  cout << "threads\ttrials/s\tflushes\tpairs" << endl;
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    auto start = chrono::steady_clock::now ();
+    HandCounts counts =
+      simulate<HandCounts> (numTrials, threads, seed, dealHand);
+    chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+
+    cout << threads << "\t" << (long) (numTrials / elapsed.count ())
+         << "\t" << counts.flushes << "\t" << counts.pairs << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+// a shuffled shoe made of whole decks, with at least n cards
+Deck makeShoe (long n, Random& rng)
+{
+  Deck one;
+  Deck shoe (0);
+  while (shoe.cards.size() < n) {
+    shoe.cards.insert (shoe.cards.end(), one.cards.begin(), one.cards.end());
+  }
+  shoe.shuffle (rng);
+  return shoe;
+}
+
+bool isLess (const Card& c1, const Card& c2)
+{
+  return c2.isGreater (c1);
+}
+
+bool isSorted (const Deck& deck)
+{
+  for (int i = 1; i < deck.cards.size(); i++) {
+    if (deck.cards[i-1].isGreater (deck.cards[i])) return false;
+  }
+  return true;
+}
+
+void report (const char* name, long n, double t, bool sorted)
+{
+  cout << "  " << name << "\t" << t * 1e3 << " ms\t"
+       << (long) (n / t) << " cards/s" << (sorted ? "" : "\tNOT SORTED")
+       << endl;
+}
+
+int main (int argc, char* argv[])
+{
+  long largest = 10000000;
+  if (argc > 1) largest = atol (argv[1]);
+  long sizes[] = { 52, 8*52, 100000, largest };
+  Random rng (17);
+
+  for (int s = 0; s < 4; s++) {
+    Deck shoe = makeShoe (sizes[s], rng);
+    long n = shoe.cards.size();
+    cout << n << " cards:" << endl;
+
+    // selection sort is quadratic, so leave it out for the big ones
+    if (n <= 100000) {
+      Deck deck = shoe;
+      auto start = chrono::steady_clock::now ();
+      deck.selectionSort ();
+      report ("selection", n, seconds (start), isSorted (deck));
+    }
+
+    Deck deck = shoe;
+    auto start = chrono::steady_clock::now ();
+    std::sort (deck.cards.begin(), deck.cards.end(), isLess);
+    report ("std::sort", n, seconds (start), isSorted (deck));
+
+    deck = shoe;
+    start = chrono::steady_clock::now ();
+    deck.sort ();
+    report ("counting", n, seconds (start), isSorted (deck));
+  }
+  return 0;
+}
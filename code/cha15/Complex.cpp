@@ -1,37 +1,9 @@
 #include <iostream>
 #include <math.h>
 #include <assert.h>
+#include <stdlib.h>
 using namespace std;
-
-class Complex
-{
-  double real, imag;
-  double mag, theta;
-  bool cartesian, polar;
-
-public:
-  void calculateCartesian ();
-  void calculatePolar ();
-
-  Complex () { cartesian = false;  polar = false; }
-
-  Complex (double r, double i)
-  {
-    real = r;  imag = i;
-    cartesian = true;  polar = false;
-  }
-
-  void printCartesian ();
-  void printPolar ();
-
-  double getReal ();
-  double getImag ();
-  double getMag ();
-  double getTheta ();
-
-  void setCartesian (double r, double i);
-  void setPolar (double m, double t);
-};
+#include "Complex.h"
 
 void Complex::setCartesian (double r, double i)
 {
@@ -46,7 +18,7 @@ void Complex::setPolar (double m, double t)
 }
 
 
-void Complex::calculateCartesian ()
+void Complex::calculateCartesian (Accuracy acc)
 {
   if (polar == false) {
     cout <<
@@ -54,16 +26,30 @@ void Complex::calculateCartesian ()
 	 << endl;
     exit (1);
   }
-  real = mag * cos (theta);
-  imag = mag * sin (theta);
+  if (acc == PRECISE) {
+    real = mag * cos (theta);
+    imag = mag * sin (theta);
+  } else {
+    double s, c;
+    if (acc == FAST) sinCosKernel<true> (theta, s, c);
+    else sinCosKernel<false> (theta, s, c);
+    real = mag * c;
+    imag = mag * s;
+  }
   cartesian = true;
 }
 
-void Complex::calculatePolar ()
+void Complex::calculatePolar (Accuracy acc)
 {
   assert (cartesian);
   mag = sqrt (real* real + imag * imag);
-  theta = atan2 (imag, real);
+  if (acc == PRECISE) {
+    theta = atan2 (imag, real);
+  } else if (acc == FAST) {
+    theta = atan2Kernel<true> (imag, real);
+  } else {
+    theta = atan2Kernel<false> (imag, real);
+  }
   polar = true;
 }
 
@@ -118,21 +104,3 @@ double Complex::getTheta ()
   if (polar == false) calculatePolar ();
   return theta;
 }
-
-int main ()
-{
-  Complex c1 (2.0, 3.0);
-  Complex c2 (3.0, 4.0);
-  c1.printCartesian();
-  c1.printPolar();
-  c2.printCartesian();
-  c2.printPolar();
-
-  Complex sum = add (c1, c2);
-  sum.printCartesian();
-
-  Complex product = mult (c1, c2);
-  product.printPolar();
-  product.printCartesian();
-  return 0;
-}
@@ -0,0 +1,42 @@
+#ifndef COMPLEX_H
+#define COMPLEX_H
+#include <iostream>
+#include "FastMath.h"
+using namespace std;
+
+class Complex
+{
+  double real, imag;
+  double mag, theta;
+  bool cartesian, polar;
+
+public:
+  void calculateCartesian (Accuracy acc = PRECISE);
+  void calculatePolar (Accuracy acc = PRECISE);
+
+  Complex () { cartesian = false;  polar = false; }
+
+  Complex (double r, double i)
+  {
+    real = r;  imag = i;
+    cartesian = true;  polar = false;
+  }
+
+  bool isCartesian () const { return cartesian; }
+  bool isPolar () const { return polar; }
+
+  void printCartesian ();
+  void printPolar ();
+
+  double getReal ();
+  double getImag ();
+  double getMag ();
+  double getTheta ();
+
+  void setCartesian (double r, double i);
+  void setPolar (double m, double t);
+};
+
+Complex add (Complex& a, Complex& b);
+Complex mult (Complex& a, Complex& b);
+#endif
@@ -0,0 +1,239 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ComplexArray.h"
+
+static double* allocate (int n)
+{
+  if (n == 0) return NULL;
+  size_t bytes = (n * sizeof (double) + 63) / 64 * 64;
+  double* p = (double*) aligned_alloc (64, bytes);
+  if (p == NULL) {
+    cout << "ComplexArray: out of memory" << endl;
+    exit (1);
+  }
+  return p;
+}
+
+static void copyColumn (double*& to, const double* from, int n)
+{
+  if (from == NULL) return;
+  if (to == NULL) to = allocate (n);
+  memcpy (to, from, n * sizeof (double));
+}
+
+ComplexArray::ComplexArray (int size)
+{
+  n = size;
+  real = allocate (n);  imag = allocate (n);
+  mag = NULL;  theta = NULL;
+  for (int i = 0; i < n; i++) {
+    real[i] = 0;  imag[i] = 0;
+  }
+  cartesian = true;  polar = false;
+}
+
+ComplexArray::ComplexArray (const ComplexArray& other)
+{
+  n = other.n;
+  real = NULL;  imag = NULL;  mag = NULL;  theta = NULL;
+  copyColumn (real, other.real, n);
+  copyColumn (imag, other.imag, n);
+  copyColumn (mag, other.mag, n);
+  copyColumn (theta, other.theta, n);
+  cartesian = other.cartesian;  polar = other.polar;
+}
+
+ComplexArray& ComplexArray::operator= (const ComplexArray& other)
+{
+  if (this == &other) return *this;
+  if (n != other.n) {
+    free (real);  free (imag);  free (mag);  free (theta);
+    real = NULL;  imag = NULL;  mag = NULL;  theta = NULL;
+    n = other.n;
+  }
+  copyColumn (real, other.real, n);
+  copyColumn (imag, other.imag, n);
+  copyColumn (mag, other.mag, n);
+  copyColumn (theta, other.theta, n);
+  cartesian = other.cartesian;  polar = other.polar;
+  return *this;
+}
+
+ComplexArray::~ComplexArray ()
+{
+  free (real);  free (imag);  free (mag);  free (theta);
+}
+
+void ComplexArray::calculateCartesian (Accuracy acc)
+{
+  if (polar == false) {
+    cout <<
+      "calculateCartesian failed because polar representation is invalid"
+         << endl;
+    exit (1);
+  }
+  if (real == NULL) real = allocate (n);
+  if (imag == NULL) imag = allocate (n);
+  fastSinCos (theta, imag, real, n, acc);
+  for (int i = 0; i < n; i++) {
+    real[i] *= mag[i];
+    imag[i] *= mag[i];
+  }
+  cartesian = true;
+}
+
+void ComplexArray::calculatePolar (Accuracy acc)
+{
+  if (cartesian == false) {
+    cout <<
+      "calculatePolar failed because cartesian representation is invalid"
+         << endl;
+    exit (1);
+  }
+  if (mag == NULL) mag = allocate (n);
+  if (theta == NULL) theta = allocate (n);
+  // the same magnitude as Complex::calculatePolar, whatever acc is
+  for (int i = 0; i < n; i++)
+    mag[i] = sqrt (real[i] * real[i] + imag[i] * imag[i]);
+  fastAtan2 (imag, real, theta, n, acc);
+  polar = true;
+}
+
+const double* ComplexArray::getReal ()
+{
+  if (cartesian == false) calculateCartesian ();
+  return real;
+}
+
+const double* ComplexArray::getImag ()
+{
+  if (cartesian == false) calculateCartesian ();
+  return imag;
+}
+
+const double* ComplexArray::getMag ()
+{
+  if (polar == false) calculatePolar ();
+  return mag;
+}
+
+const double* ComplexArray::getTheta ()
+{
+  if (polar == false) calculatePolar ();
+  return theta;
+}
+
+double* ComplexArray::writeReal ()
+{
+  if (cartesian == false) calculateCartesian ();
+  polar = false;
+  return real;
+}
+
+double* ComplexArray::writeImag ()
+{
+  if (cartesian == false) calculateCartesian ();
+  polar = false;
+  return imag;
+}
+
+double* ComplexArray::writeMag ()
+{
+  if (polar == false) calculatePolar ();
+  cartesian = false;
+  return mag;
+}
+
+double* ComplexArray::writeTheta ()
+{
+  if (polar == false) calculatePolar ();
+  cartesian = false;
+  return theta;
+}
+
+Complex ComplexArray::get (int i)
+{
+  if (cartesian) return Complex (real[i], imag[i]);
+  Complex c;
+  c.setPolar (mag[i], theta[i]);
+  return c;
+}
+
+void ComplexArray::set (int i, Complex& c)
+{
+  setCartesian (i, c.getReal(), c.getImag());
+}
+
+void ComplexArray::setCartesian (int i, double r, double im)
+{
+  if (cartesian == false) calculateCartesian ();
+  real[i] = r;  imag[i] = im;
+  polar = false;
+}
+
+// both representations stay valid
+void ComplexArray::conjugate ()
+{
+  if (cartesian) {
+    double* __restrict im = imag;
+    for (int i = 0; i < n; i++) im[i] = -im[i];
+  }
+  if (polar) {
+    double* __restrict t = theta;
+    for (int i = 0; i < n; i++) t[i] = -t[i];
+  }
+}
+
+void ComplexArray::scale (double s)
+{
+  if (cartesian) {
+    double* __restrict re = real;
+    double* __restrict im = imag;
+    for (int i = 0; i < n; i++) {
+      re[i] *= s;  im[i] *= s;
+    }
+  }
+  if (polar) {
+    double* __restrict m = mag;
+    double* __restrict t = theta;
+    double shift = (s < 0) ? M_PI : 0;
+    double factor = fabs (s);
+    for (int i = 0; i < n; i++) {
+      m[i] *= factor;  t[i] += shift;
+    }
+  }
+}
+
+void add (ComplexArray& a, ComplexArray& b, ComplexArray& out)
+{
+  int n = a.size();
+  const double* ar = a.getReal ();
+  const double* ai = a.getImag ();
+  const double* br = b.getReal ();
+  const double* bi = b.getImag ();
+  double* re = out.writeReal ();
+  double* im = out.writeImag ();
+  for (int i = 0; i < n; i++) {
+    re[i] = ar[i] + br[i];
+    im[i] = ai[i] + bi[i];
+  }
+}
+
+// in Cartesian form: four multiplies and no trig
+void mult (ComplexArray& a, ComplexArray& b, ComplexArray& out)
+{
+  int n = a.size();
+  const double* ar = a.getReal ();
+  const double* ai = a.getImag ();
+  const double* br = b.getReal ();
+  const double* bi = b.getImag ();
+  double* re = out.writeReal ();
+  double* im = out.writeImag ();
+  for (int i = 0; i < n; i++) {
+    double r = ar[i] * br[i] - ai[i] * bi[i];
+    double m = ar[i] * bi[i] + ai[i] * br[i];
+    re[i] = r;
+    im[i] = m;
+  }
+}
@@ -0,0 +1,54 @@
+#ifndef COMPLEXARRAY_H
+#define COMPLEXARRAY_H
+#include "Complex.h"
+
+// Many complex numbers stored as separate arrays (real parts, imaginary
+// parts, and when they are asked for, magnitudes and angles) instead
+// of as an array of Complex.  Each array is 64-byte aligned and the
+// loops over them are simple enough for the compiler to vectorize.
+// Like Complex, the array remembers which representation is valid and
+// converts the whole array when the other one is needed.
+class ComplexArray
+{
+  int n;
+  double *real, *imag;
+  double *mag, *theta;     // allocated the first time they are needed
+  bool cartesian, polar;
+
+public:
+  ComplexArray (int size = 0);
+  ComplexArray (const ComplexArray& other);
+  ComplexArray& operator= (const ComplexArray& other);
+  ~ComplexArray ();
+
+  int size () const { return n; }
+  bool isCartesian () const { return cartesian; }
+  bool isPolar () const { return polar; }
+
+  void calculateCartesian (Accuracy acc = PRECISE);
+  void calculatePolar (Accuracy acc = PRECISE);
+
+  // read-only columns, converted first if need be
+  const double* getReal ();
+  const double* getImag ();
+  const double* getMag ();
+  const double* getTheta ();
+
+  // columns to write into; the other representation becomes invalid
+  double* writeReal ();
+  double* writeImag ();
+  double* writeMag ();
+  double* writeTheta ();
+
+  Complex get (int i);
+  void set (int i, Complex& c);
+  void setCartesian (int i, double r, double im);
+
+  void conjugate ();
+  void scale (double s);
+};
+
+// out[i] = a[i] + b[i] and out[i] = a[i] * b[i]; out may be a or b
+void add (ComplexArray& a, ComplexArray& b, ComplexArray& out);
+void mult (ComplexArray& a, ComplexArray& b, ComplexArray& out);
+#endif
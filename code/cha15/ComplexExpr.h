@@ -0,0 +1,276 @@
+#ifndef COMPLEXEXPR_H
+#define COMPLEXEXPR_H
+#include <math.h>
+#include <type_traits>
+#include "Complex.h"
+#include "ComplexArray.h"
+
+// Operators +, - and * for Complex and ComplexArray that build an
+// expression instead of computing it.  Nothing happens until the
+// expression is turned into a Complex or written into a ComplexArray
+// with evaluate.  Then:
+//
+//  - each node works out how many conversions between Cartesian and
+//    polar form it would need to produce its value either way (sums
+//    need Cartesian form, products can be done in either), and picks
+//    the cheaper one, so a*b + c*d does no trig at all when a, b, c
+//    and d are Cartesian;
+//  - for arrays, every leaf is converted (if at all) once, before the
+//    loop, and the whole expression runs as one loop over the elements
+//    with no temporary arrays.
+//
+// Each node has:
+//   int cost (bool cart)       conversions needed to get the value in
+//                              Cartesian (cart) or polar form
+//   void prepare (bool cart)   make those choices and convert leaves
+//   void cartesian (i, re, im) the value of element i
+//   void polar (i, mag, theta)
+// Leaves hold references, so the operands must outlive the expression.
+
+template <class E>
+struct ComplexExpr {
+  const E& self () const { return static_cast<const E&> (*this); }
+
+  // evaluating into a single Complex
+  operator Complex () const {
+    E e = self ();
+    bool cart = e.cost (true) <= e.cost (false);
+    e.prepare (cart);
+    Complex result;
+    double a, b;
+    if (cart) {
+      e.cartesian (0, a, b);
+      result.setCartesian (a, b);
+    } else {
+      e.polar (0, a, b);
+      result.setPolar (a, b);
+    }
+    return result;
+  }
+};
+
+inline void toPolar (double re, double im, double& mag, double& theta)
+{
+  mag = sqrt (re * re + im * im);
+  theta = atan2 (im, re);
+}
+
+inline void toCartesian (double mag, double theta, double& re, double& im)
+{
+  re = mag * cos (theta);
+  im = mag * sin (theta);
+}
+
+// a Complex, the same value for every element
+struct ComplexRef : ComplexExpr<ComplexRef> {
+  Complex* c;
+  double re, im, mag, theta;
+
+  ComplexRef (Complex& value) { c = &value; }
+
+  int cost (bool cart) const {
+    return (cart ? c->isCartesian () : c->isPolar ()) ? 0 : 1;
+  }
+  void prepare (bool cart) {
+    if (cart) {
+      re = c->getReal ();  im = c->getImag ();
+    } else {
+      mag = c->getMag ();  theta = c->getTheta ();
+    }
+  }
+  void cartesian (int, double& r, double& i) const { r = re;  i = im; }
+  void polar (int, double& m, double& t) const { m = mag;  t = theta; }
+};
+
+struct ArrayRef : ComplexExpr<ArrayRef> {
+  ComplexArray* a;
+  const double *re, *im, *mag, *theta;
+
+  ArrayRef (ComplexArray& array) { a = &array; }
+
+  int cost (bool cart) const {
+    return (cart ? a->isCartesian () : a->isPolar ()) ? 0 : 1;
+  }
+  void prepare (bool cart) {
+    if (cart) {
+      re = a->getReal ();  im = a->getImag ();
+    } else {
+      mag = a->getMag ();  theta = a->getTheta ();
+    }
+  }
+  void cartesian (int i, double& r, double& m) const { r = re[i];  m = im[i]; }
+  void polar (int i, double& m, double& t) const { m = mag[i];  t = theta[i]; }
+};
+
+// a + b and a - b (sign -1): always done in Cartesian form
+template <class L, class R, int SIGN>
+struct SumExpr : ComplexExpr<SumExpr<L, R, SIGN> > {
+  L left;
+  R right;
+
+  SumExpr (const L& l, const R& r) : left (l), right (r) {}
+
+  int cost (bool cart) const {
+    int c = left.cost (true) + right.cost (true);
+    return cart ? c : c + 1;
+  }
+  void prepare (bool) {
+    left.prepare (true);
+    right.prepare (true);
+  }
+  void cartesian (int i, double& re, double& im) const {
+    double ar, ai, br, bi;
+    left.cartesian (i, ar, ai);
+    right.cartesian (i, br, bi);
+    re = ar + SIGN * br;
+    im = ai + SIGN * bi;
+  }
+  void polar (int i, double& mag, double& theta) const {
+    double re, im;
+    cartesian (i, re, im);
+    toPolar (re, im, mag, theta);
+  }
+};
+
+// a * b: in whichever form the operands already are
+template <class L, class R>
+struct ProductExpr : ComplexExpr<ProductExpr<L, R> > {
+  L left;
+  R right;
+  bool inCartesian;
+
+  ProductExpr (const L& l, const R& r) : left (l), right (r) {
+    inCartesian = true;
+  }
+
+  int cost (bool cart) const {
+    int c = left.cost (true) + right.cost (true);
+    int p = left.cost (false) + right.cost (false);
+    return cart ? min (c, p + 1) : min (p, c + 1);
+  }
+  void prepare (bool cart) {
+    int c = left.cost (true) + right.cost (true);
+    int p = left.cost (false) + right.cost (false);
+    inCartesian = cart ? (c <= p + 1) : (c + 1 < p);
+    left.prepare (inCartesian);
+    right.prepare (inCartesian);
+  }
+  void cartesian (int i, double& re, double& im) const {
+    if (inCartesian) {
+      double ar, ai, br, bi;
+      left.cartesian (i, ar, ai);
+      right.cartesian (i, br, bi);
+      re = ar * br - ai * bi;
+      im = ar * bi + ai * br;
+    } else {
+      double mag, theta;
+      polar (i, mag, theta);
+      toCartesian (mag, theta, re, im);
+    }
+  }
+  void polar (int i, double& mag, double& theta) const {
+    if (inCartesian) {
+      double re, im;
+      cartesian (i, re, im);
+      toPolar (re, im, mag, theta);
+    } else {
+      double am, at, bm, bt;
+      left.polar (i, am, at);
+      right.polar (i, bm, bt);
+      mag = am * bm;
+      theta = at + bt;
+    }
+  }
+};
+
+// Which types can be operands, and what node each one becomes:
+// a Complex or ComplexArray becomes a reference to it, and an
+// expression is copied into its parent by value.
+template <class T, class Enable = void>
+struct Operand {
+  static const bool ok = false;
+  typedef void type;
+};
+
+template <class T>
+struct Operand<T, typename std::enable_if<
+  std::is_base_of<ComplexExpr<T>, T>::value>::type> {
+  static const bool ok = true;
+  typedef T type;
+};
+
+template <>
+struct Operand<Complex> {
+  static const bool ok = true;
+  typedef ComplexRef type;
+};
+
+template <>
+struct Operand<ComplexArray> {
+  static const bool ok = true;
+  typedef ArrayRef type;
+};
+
+template <class T>
+struct Node {
+  typedef typename Operand<typename std::decay<T>::type>::type type;
+};
+
+template <class A, class B>
+struct BothOperands {
+  static const bool value = Operand<typename std::decay<A>::type>::ok &&
+                            Operand<typename std::decay<B>::type>::ok;
+};
+
+inline ComplexRef wrapOperand (Complex& c) { return ComplexRef (c); }
+inline ArrayRef wrapOperand (ComplexArray& a) { return ArrayRef (a); }
+template <class E>
+const E& wrapOperand (const ComplexExpr<E>& e) { return e.self (); }
+
+template <class A, class B>
+typename std::enable_if<BothOperands<A, B>::value,
+  SumExpr<typename Node<A>::type, typename Node<B>::type, 1> >::type
+operator+ (A&& a, B&& b)
+{
+  return SumExpr<typename Node<A>::type, typename Node<B>::type, 1>
+    (wrapOperand (a), wrapOperand (b));
+}
+
+template <class A, class B>
+typename std::enable_if<BothOperands<A, B>::value,
+  SumExpr<typename Node<A>::type, typename Node<B>::type, -1> >::type
+operator- (A&& a, B&& b)
+{
+  return SumExpr<typename Node<A>::type, typename Node<B>::type, -1>
+    (wrapOperand (a), wrapOperand (b));
+}
+
+template <class A, class B>
+typename std::enable_if<BothOperands<A, B>::value,
+  ProductExpr<typename Node<A>::type, typename Node<B>::type> >::type
+operator* (A&& a, B&& b)
+{
+  return ProductExpr<typename Node<A>::type, typename Node<B>::type>
+    (wrapOperand (a), wrapOperand (b));
+}
+
+// out[i] = expr[i] for every element, in one loop.  out may also
+// appear in the expression.
+template <class E>
+void evaluate (const ComplexExpr<E>& expr, ComplexArray& out)
+{
+  E e = expr.self ();
+  bool cart = e.cost (true) <= e.cost (false);
+  e.prepare (cart);
+  int n = out.size ();
+  if (cart) {
+    double* re = out.writeReal ();
+    double* im = out.writeImag ();
+    for (int i = 0; i < n; i++) e.cartesian (i, re[i], im[i]);
+  } else {
+    double* mag = out.writeMag ();
+    double* theta = out.writeTheta ();
+    for (int i = 0; i < n; i++) e.polar (i, mag[i], theta[i]);
+  }
+}
+#endif
@@ -0,0 +1,237 @@
+#include <math.h>
+#include <stdlib.h>
+#include <thread>
+#include "FFT.h"
+
+// below this size threads cost more than they save
+const int MIN_PARALLEL_SIZE = 1 << 16;
+
+FFT::FFT (int size)
+{
+  n = size;
+  logn = 0;
+  while ((1 << logn) < n) logn++;
+  if ((1 << logn) != n) {
+    cout << "FFT size " << n << " is not a power of two" << endl;
+    exit (1);
+  }
+
+  // w(h, j) = e^(-pi i j/h) for j < h, for every pass
+  twiddleRe.resize (n > 1 ? n : 1);
+  twiddleIm.resize (n > 1 ? n : 1);
+  for (int h = 1; h < n; h *= 2) {
+    for (int j = 0; j < h; j++) {
+      twiddleRe[h + j] = cos (M_PI * j / h);
+      twiddleIm[h + j] = -sin (M_PI * j / h);
+    }
+  }
+}
+
+// swaps element i with element reverse(i), for i in [first, last).
+// Each pair is swapped by whichever end is smaller, so separate ranges
+// can be done by separate threads.
+void FFT::bitReverse (double* re, double* im, int first, int last) const
+{
+  for (int i = first; i < last; i++) {
+    int r = 0;
+    for (int b = 0, x = i; b < logn; b++, x >>= 1) r = (r << 1) | (x & 1);
+    if (i < r) {
+      double t = re[i];  re[i] = re[r];  re[r] = t;
+      t = im[i];  im[i] = im[r];  im[r] = t;
+    }
+  }
+}
+
+// one pass of butterflies with half-length half, only for the offsets
+// j in [firstJ, lastJ) of every block
+void FFT::butterflies (double* re, double* im, int half,
+                       int firstJ, int lastJ) const
+{
+  const double* wr = &twiddleRe[half];
+  const double* wi = &twiddleIm[half];
+  for (int start = 0; start < n; start += 2 * half) {
+    double* __restrict ar = re + start;
+    double* __restrict ai = im + start;
+    double* __restrict br = re + start + half;
+    double* __restrict bi = im + start + half;
+    for (int j = firstJ; j < lastJ; j++) {
+      double tr = wr[j] * br[j] - wi[j] * bi[j];
+      double ti = wr[j] * bi[j] + wi[j] * br[j];
+      br[j] = ar[j] - tr;  bi[j] = ai[j] - ti;
+      ar[j] += tr;         ai[j] += ti;
+    }
+  }
+}
+
+// All the passes with half-length from minHalf to maxHalf, on the
+// elements [first, last), which must be a whole number of blocks.
+// The passes with half-length 1 and 2 are done together as radix-4
+// butterflies, whose twiddles are only 1 and -i.
+void FFT::passes (double* re, double* im, int first, int last,
+                  int minHalf, int maxHalf) const
+{
+  int h = minHalf;
+  if (h == 1 && maxHalf >= 2) {
+    for (int i = first; i < last; i += 4) {
+      double r0 = re[i] + re[i+1], i0 = im[i] + im[i+1];
+      double r1 = re[i] - re[i+1], i1 = im[i] - im[i+1];
+      double r2 = re[i+2] + re[i+3], i2 = im[i+2] + im[i+3];
+      double r3 = re[i+2] - re[i+3], i3 = im[i+2] - im[i+3];
+      re[i]   = r0 + r2;  im[i]   = i0 + i2;
+      re[i+2] = r0 - r2;  im[i+2] = i0 - i2;
+      // (r3 + i i3) * -i = i3 - i r3
+      re[i+1] = r1 + i3;  im[i+1] = i1 - r3;
+      re[i+3] = r1 - i3;  im[i+3] = i1 + r3;
+    }
+    h = 4;
+  }
+  for (; h <= maxHalf; h *= 2) {
+    const double* wr = &twiddleRe[h];
+    const double* wi = &twiddleIm[h];
+    for (int start = first; start < last; start += 2 * h) {
+      double* __restrict ar = re + start;
+      double* __restrict ai = im + start;
+      double* __restrict br = re + start + h;
+      double* __restrict bi = im + start + h;
+      for (int j = 0; j < h; j++) {
+        double tr = wr[j] * br[j] - wi[j] * bi[j];
+        double ti = wr[j] * bi[j] + wi[j] * br[j];
+        br[j] = ar[j] - tr;  bi[j] = ai[j] - ti;
+        ar[j] += tr;         ai[j] += ti;
+      }
+    }
+  }
+}
+
+// With T threads the array is cut into T chunks.  The early passes
+// only mix elements within a chunk, so each thread does all of them on
+// its own chunk while it is still in cache.  The last log2(T) passes
+// mix chunks together; for those the threads split each block's
+// butterflies between them instead.
+void FFT::forward (double* re, double* im, int numThreads) const
+{
+  if (n < 2) return;
+  int threads = 1;
+  while (threads * 2 <= numThreads && n / (threads * 2) >= MIN_PARALLEL_SIZE / 4) {
+    threads *= 2;
+  }
+  if (n < MIN_PARALLEL_SIZE) threads = 1;
+
+  if (threads == 1) {
+    bitReverse (re, im, 0, n);
+    passes (re, im, 0, n, 1, n / 2);
+    return;
+  }
+
+  int chunk = n / threads;
+  vector<thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.push_back (thread (&FFT::bitReverse, this, re, im,
+                               t * chunk, (t + 1) * chunk));
+  }
+  for (int t = 0; t < threads; t++) workers[t].join ();
+  workers.clear ();
+
+  for (int t = 0; t < threads; t++) {
+    workers.push_back (thread (&FFT::passes, this, re, im,
+                               t * chunk, (t + 1) * chunk, 1, chunk / 2));
+  }
+  for (int t = 0; t < threads; t++) workers[t].join ();
+
+  for (int h = chunk; h < n; h *= 2) {
+    workers.clear ();
+    int share = h / threads;
+    for (int t = 0; t < threads; t++) {
+      workers.push_back (thread (&FFT::butterflies, this, re, im, h,
+                                 t * share, (t + 1) * share));
+    }
+    for (int t = 0; t < threads; t++) workers[t].join ();
+  }
+}
+
+// the inverse is the forward transform of the conjugate, conjugated
+// and divided by n
+void FFT::inverse (double* re, double* im, int numThreads) const
+{
+  for (int i = 0; i < n; i++) im[i] = -im[i];
+  forward (re, im, numThreads);
+  double scale = 1.0 / n;
+  for (int i = 0; i < n; i++) {
+    re[i] *= scale;
+    im[i] *= -scale;
+  }
+}
+
+void FFT::forward (ComplexArray& a, int numThreads) const
+{
+  double* re = a.writeReal ();
+  double* im = a.writeImag ();
+  forward (re, im, numThreads);
+}
+
+void FFT::inverse (ComplexArray& a, int numThreads) const
+{
+  double* re = a.writeReal ();
+  double* im = a.writeImag ();
+  inverse (re, im, numThreads);
+}
+
+void FFT::forward (vector<Complex>& v) const
+{
+  ComplexArray a (n);
+  for (int i = 0; i < n; i++) a.set (i, v[i]);
+  forward (a);
+  const double* re = a.getReal ();
+  const double* im = a.getImag ();
+  for (int i = 0; i < n; i++) v[i].setCartesian (re[i], im[i]);
+}
+
+RealFFT::RealFFT (int size) : half (size / 2)
+{
+  n = size;
+  wRe.resize (n / 2 + 1);
+  wIm.resize (n / 2 + 1);
+  for (int k = 0; k <= n / 2; k++) {
+    wRe[k] = cos (2 * M_PI * k / n);
+    wIm[k] = -sin (2 * M_PI * k / n);
+  }
+}
+
+// Pack the even samples into the real parts and the odd ones into the
+// imaginary parts, transform, then untangle: with Z = FFT(z),
+//   E[k] = (Z[k] + conj Z[m-k]) / 2,  O[k] = (Z[k] - conj Z[m-k]) / 2i
+// and X[k] = E[k] + w^k O[k], where m = n/2.
+void RealFFT::forward (const double* x, double* outRe, double* outIm,
+                       int numThreads) const
+{
+  int m = n / 2;
+  vector<double> zr (m), zi (m);
+  for (int j = 0; j < m; j++) {
+    zr[j] = x[2*j];
+    zi[j] = x[2*j + 1];
+  }
+  half.forward (zr.data(), zi.data(), numThreads);
+
+  for (int k = 0; k <= m; k++) {
+    int a = k % m, b = (m - k) % m;
+    double er = (zr[a] + zr[b]) / 2, ei = (zi[a] - zi[b]) / 2;
+    double or_ = (zi[a] + zi[b]) / 2, oi = -(zr[a] - zr[b]) / 2;
+    outRe[k] = er + wRe[k] * or_ - wIm[k] * oi;
+    outIm[k] = ei + wRe[k] * oi + wIm[k] * or_;
+  }
+}
+
+void naiveDFT (const double* re, const double* im,
+               double* outRe, double* outIm, int n)
+{
+  for (int k = 0; k < n; k++) {
+    double sr = 0, si = 0;
+    for (int j = 0; j < n; j++) {
+      double angle = -2 * M_PI * ((long) j * k % n) / n;
+      double c = cos (angle), s = sin (angle);
+      sr += re[j] * c - im[j] * s;
+      si += re[j] * s + im[j] * c;
+    }
+    outRe[k] = sr;  outIm[k] = si;
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef FFT_H
+#define FFT_H
+#include <vector>
+#include "Complex.h"
+#include "ComplexArray.h"
+using namespace std;
+
+// A fast Fourier transform of one fixed size (a power of two).  The
+// constructor works out all the twiddle factors once; after that a
+// transform is a bit-reversal permutation done in place followed by
+// log2(n) passes of butterflies, the first two of them fused into one
+// radix-4 pass that needs no multiplies.  Each pass reads its twiddles
+// from one contiguous table, so the inner loops run with unit stride
+// over the real and imaginary arrays.
+//
+// Forward transforms compute X[k] = sum x[j] e^(-2 pi i jk/n).
+class FFT
+{
+  int n, logn;
+  vector<double> twiddleRe, twiddleIm;   // the pass with half-length h
+                                         // starts at index h
+public:
+  FFT (int size);
+  int size () const { return n; }
+
+  // in place on separate real and imaginary arrays; large transforms
+  // are split between numThreads threads
+  void forward (double* re, double* im, int numThreads = 1) const;
+  void inverse (double* re, double* im, int numThreads = 1) const;
+
+  void forward (ComplexArray& a, int numThreads = 1) const;
+  void inverse (ComplexArray& a, int numThreads = 1) const;
+  void forward (vector<Complex>& v) const;
+
+  void bitReverse (double* re, double* im, int first, int last) const;
+  void passes (double* re, double* im, int first, int last,
+               int minHalf, int maxHalf) const;
+  void butterflies (double* re, double* im, int half,
+                    int firstJ, int lastJ) const;
+};
+
+// The transform of n real numbers, done as a complex transform of half
+// the size.  Since the output is conjugate-symmetric only the bins 0
+// to n/2 are computed.
+class RealFFT
+{
+  int n;
+  FFT half;
+  vector<double> wRe, wIm;
+
+public:
+  RealFFT (int size);
+  int size () const { return n; }
+
+  // outRe and outIm have room for n/2 + 1 values
+  void forward (const double* x, double* outRe, double* outIm,
+                int numThreads = 1) const;
+};
+
+// the O(n^2) definition, for checking
+void naiveDFT (const double* re, const double* im,
+               double* outRe, double* outIm, int n);
+#endif
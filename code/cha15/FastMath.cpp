@@ -0,0 +1,52 @@
+#include "FastMath.h"
+
+// Each tier has its own loop, so the loop bodies have no tests of acc.
+template <bool FAST>
+static void sinCosLoop (const double* __restrict x, double* __restrict s,
+                        double* __restrict c, int n)
+{
+  for (int i = 0; i < n; i++) sinCosKernel<FAST> (x[i], s[i], c[i]);
+}
+
+template <bool FAST>
+static void atan2Loop (const double* __restrict y, const double* __restrict x,
+                       double* __restrict out, int n)
+{
+  for (int i = 0; i < n; i++) out[i] = atan2Kernel<FAST> (y[i], x[i]);
+}
+
+void fastSinCos (const double* x, double* s, double* c, int n, Accuracy acc)
+{
+  if (acc == PRECISE) {
+    for (int i = 0; i < n; i++) {
+      s[i] = sin (x[i]);
+      c[i] = cos (x[i]);
+    }
+  } else if (acc == MEDIUM) {
+    sinCosLoop<false> (x, s, c, n);
+  } else {
+    sinCosLoop<true> (x, s, c, n);
+  }
+}
+
+void fastAtan2 (const double* y, const double* x, double* out, int n,
+                Accuracy acc)
+{
+  if (acc == PRECISE) {
+    for (int i = 0; i < n; i++) out[i] = atan2 (y[i], x[i]);
+  } else if (acc == MEDIUM) {
+    atan2Loop<false> (y, x, out, n);
+  } else {
+    atan2Loop<true> (y, x, out, n);
+  }
+}
+
+void fastHypot (const double* __restrict x, const double* __restrict y,
+                double* __restrict out, int n, Accuracy acc)
+{
+  if (acc == PRECISE) {
+    for (int i = 0; i < n; i++) out[i] = hypot (x[i], y[i]);
+  } else {
+    for (int i = 0; i < n; i++) out[i] = sqrt (x[i] * x[i] + y[i] * y[i]);
+  }
+}
@@ -0,0 +1,103 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+#include <math.h>
+
+// sin/cos, atan2 and hypot over whole arrays, at three accuracies:
+//
+//   PRECISE  the C library (correct to about 1 ulp)
+//   MEDIUM   polynomials good to about 1e-8 (absolute)
+//   FAST     short polynomials: sin/cos within 4e-4, atan2 within 2e-5
+//
+// The MEDIUM and FAST kernels have no branches and no calls, and the
+// tier is a template parameter rather than a test inside the loop, so
+// the loops over them vectorize (the sqrt in hypot needs
+// -fno-math-errno, or the compiler has to keep a scalar call in case
+// it sets errno).  Their sin/cos reduce the argument with a two-part
+// pi/2, which is fine for angles up to about 1e5 radians.  Their hypot
+// is the plain sqrt(x*x + y*y), which can overflow for values beyond
+// 1e154 where the library's does not.
+enum Accuracy { PRECISE, MEDIUM, FAST };
+
+const double PI_2_HI = 1.57079632673412561417e+00;
+const double PI_2_LO = 6.07710050650619224932e-11;
+const double TWO_OVER_PI = 0.63661977236758134308;
+
+// adding and taking away 1.5 * 2^52 rounds a double to the nearest
+// integer (for magnitudes below 2^51) without calling floor, which
+// does not vectorize unless traps are turned off
+const double ROUNDER = 6755399441055744.0;
+
+inline double roundKernel (double x)
+{
+  return (x + ROUNDER) - ROUNDER;
+}
+
+template <bool FAST>
+inline void sinCosKernel (double x, double& s, double& c)
+{
+  double k = roundKernel (x * TWO_OVER_PI);
+  double r = (x - k * PI_2_HI) - k * PI_2_LO;    // |r| <= pi/4
+  double r2 = r * r;
+  double sr, cr;
+  if (FAST) {
+    sr = r * (1 + r2 * (-1.0/6 + r2 * (1.0/120)));
+    cr = 1 + r2 * (-0.5 + r2 * (1.0/24));
+  } else {
+    sr = r * (1 + r2 * (-1.0/6 + r2 * (1.0/120 + r2 * (-1.0/5040
+         + r2 * (1.0/362880 + r2 * (-1.0/39916800))))));
+    cr = 1 + r2 * (-0.5 + r2 * (1.0/24 + r2 * (-1.0/720
+         + r2 * (1.0/40320 + r2 * (-1.0/3628800)))));
+  }
+  // which quarter turn x was in, 0 to 3, worked out in doubles so
+  // there is no conversion to an integer
+  double q = k - 4 * roundKernel (k * 0.25 - 0.375);
+  bool odd = (q == 1) | (q == 3);
+  double s1 = odd ? cr : sr;
+  double c1 = odd ? sr : cr;
+  s = (q >= 2) ? -s1 : s1;
+  c = ((q == 1) | (q == 2)) ? -c1 : c1;
+}
+
+template <bool FAST>
+inline double atanKernel (double a)
+{
+  // a is in [0, 1]
+  if (FAST) {
+    // minimax fit from Abramowitz and Stegun 4.4.49, within 1e-5
+    double a2 = a * a;
+    return a * (0.9998660 + a2 * (-0.3302995 + a2 * (0.1801410
+           + a2 * (-0.0851330 + a2 * 0.0208351))));
+  }
+  // atan (a) = pi/4 + atan ((a-1)/(a+1)) brings a above tan(pi/8)
+  // down to |t| <= tan(pi/8), where the series converges quickly
+  bool big = a > 0.41421356237309504880;
+  double t = big ? (a - 1) / (a + 1) : a;
+  double t2 = t * t;
+  double p = t * (1 + t2 * (-1.0/3 + t2 * (1.0/5 + t2 * (-1.0/7
+             + t2 * (1.0/9 + t2 * (-1.0/11 + t2 * (1.0/13
+             + t2 * (-1.0/15 + t2 * (1.0/17)))))))));
+  return big ? M_PI_4 + p : p;
+}
+
+template <bool FAST>
+inline double atan2Kernel (double y, double x)
+{
+  double ax = fabs (x), ay = fabs (y);
+  double hi = ax > ay ? ax : ay;
+  double lo = ax > ay ? ay : ax;
+  double a = (hi == 0) ? 0 : lo / hi;
+  double r = atanKernel<FAST> (a);
+  r = (ay > ax) ? M_PI_2 - r : r;
+  // the sign bits, not comparisons, so that -0 behaves as in atan2:
+  // atan2 (-0, -1) is -pi and atan2 (+0, -0) is pi (copysign rather
+  // than signbit, which does not vectorize)
+  r = (copysign (1.0, x) < 0) ? M_PI - r : r;
+  return copysign (r, y);
+}
+
+void fastSinCos (const double* x, double* s, double* c, int n, Accuracy acc);
+void fastAtan2 (const double* y, const double* x, double* out, int n,
+                Accuracy acc);
+void fastHypot (const double* x, const double* y, double* out, int n,
+                Accuracy acc);
+#endif
@@ -0,0 +1,196 @@
+#include <atomic>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include "Fractal.h"
+
+Fractal::Fractal (int w, int h, double x, double y, double scale, int iter)
+{
+  width = w;  height = h;  maxIter = iter;
+  step = scale / width;
+  left = x - step * (width - 1) / 2;
+  top = y + step * (height - 1) / 2;
+  julia = false;
+  juliaRe = 0;  juliaIm = 0;
+}
+
+void Fractal::setJulia (double re, double im)
+{
+  julia = true;
+  juliaRe = re;  juliaIm = im;
+}
+
+// Iterates the LANES pixels of one group and writes their counts.  The
+// lanes run in vector registers: each step computes a mask of the lanes
+// still inside |z| <= 2, adds 1 to their counts under that mask, updates
+// only their z, and stops when the mask is empty.  valid has 1 for
+// lanes that are real pixels (the last group of a row may be short).
+static void iterateLanes (const double* zr0, const double* zi0,
+                          const double* cr0, const double* ci0,
+                          const int* valid, int maxIter, int* out)
+{
+#if defined(__AVX512F__)
+  __m512d zr = _mm512_loadu_pd (zr0), zi = _mm512_loadu_pd (zi0);
+  __m512d cr = _mm512_loadu_pd (cr0), ci = _mm512_loadu_pd (ci0);
+  __m512d four = _mm512_set1_pd (4.0), one = _mm512_set1_pd (1.0);
+  __m512d count = _mm512_setzero_pd ();
+  __mmask8 active = 0;
+  for (int k = 0; k < 8; k++) active |= (valid[k] != 0) << k;
+
+  for (int i = 0; i < maxIter; i++) {
+    __m512d rr = _mm512_mul_pd (zr, zr), ii = _mm512_mul_pd (zi, zi);
+    active = _mm512_mask_cmp_pd_mask (active, _mm512_add_pd (rr, ii), four,
+                                      _CMP_LE_OQ);
+    if (active == 0) break;
+    count = _mm512_mask_add_pd (count, active, count, one);
+    __m512d twoZr = _mm512_add_pd (zr, zr);
+    zr = _mm512_mask_add_pd (zr, active, _mm512_sub_pd (rr, ii), cr);
+    zi = _mm512_mask_fmadd_pd (zi, active, twoZr, ci);    // 2 zr zi + ci
+  }
+  double counts[8];
+  _mm512_storeu_pd (counts, count);
+  for (int k = 0; k < 8; k++) out[k] = (int) counts[k];
+#elif defined(__AVX2__) && defined(__FMA__)
+  // two registers of four lanes each
+  __m256d zr[2], zi[2], cr[2], ci[2], count[2], active[2];
+  __m256d four = _mm256_set1_pd (4.0), one = _mm256_set1_pd (1.0);
+  for (int h = 0; h < 2; h++) {
+    zr[h] = _mm256_loadu_pd (zr0 + 4*h);
+    zi[h] = _mm256_loadu_pd (zi0 + 4*h);
+    cr[h] = _mm256_loadu_pd (cr0 + 4*h);
+    ci[h] = _mm256_loadu_pd (ci0 + 4*h);
+    count[h] = _mm256_setzero_pd ();
+    __m128i v = _mm_loadu_si128 ((const __m128i*) (valid + 4*h));
+    __m256i wide = _mm256_cvtepi32_epi64 (v);
+    active[h] = _mm256_castsi256_pd (
+      _mm256_cmpgt_epi64 (wide, _mm256_setzero_si256 ()));
+  }
+
+  for (int i = 0; i < maxIter; i++) {
+    for (int h = 0; h < 2; h++) {
+      __m256d rr = _mm256_mul_pd (zr[h], zr[h]);
+      __m256d ii = _mm256_mul_pd (zi[h], zi[h]);
+      __m256d inside = _mm256_cmp_pd (_mm256_add_pd (rr, ii), four,
+                                      _CMP_LE_OQ);
+      active[h] = _mm256_and_pd (active[h], inside);
+      count[h] = _mm256_add_pd (count[h], _mm256_and_pd (active[h], one));
+      __m256d nr = _mm256_add_pd (_mm256_sub_pd (rr, ii), cr[h]);
+      __m256d twoZr = _mm256_add_pd (zr[h], zr[h]);
+      __m256d ni = _mm256_fmadd_pd (twoZr, zi[h], ci[h]);
+      zr[h] = _mm256_blendv_pd (zr[h], nr, active[h]);
+      zi[h] = _mm256_blendv_pd (zi[h], ni, active[h]);
+    }
+    if (_mm256_movemask_pd (_mm256_or_pd (active[0], active[1])) == 0) break;
+  }
+  double counts[8];
+  _mm256_storeu_pd (counts, count[0]);
+  _mm256_storeu_pd (counts + 4, count[1]);
+  for (int k = 0; k < 8; k++) out[k] = (int) counts[k];
+#else
+  // the same steps one lane at a time
+  for (int k = 0; k < 8; k++) {
+    double zr = zr0[k], zi = zi0[k];
+    int i = 0;
+    while (valid[k] && i < maxIter && zr * zr + zi * zi <= 4.0) {
+      double nr = zr * zr - zi * zi + cr0[k];
+      zi = 2 * zr * zi + ci0[k];
+      zr = nr;
+      i++;
+    }
+    out[k] = i;
+  }
+#endif
+}
+
+void Fractal::renderTile (int* counts, int x0, int y0, int x1, int y1) const
+{
+  const int L = LANES;
+  double zr[L], zi[L], cr[L], ci[L];
+  int valid[L], count[L];
+
+  for (int y = y0; y < y1; y++) {
+    double py = top - y * step;
+    for (int x = x0; x < x1; x += L) {
+      for (int k = 0; k < L; k++) {
+        double px = left + (x + k) * step;
+        zr[k] = julia ? px : 0;
+        zi[k] = julia ? py : 0;
+        cr[k] = julia ? juliaRe : px;
+        ci[k] = julia ? juliaIm : py;
+        valid[k] = (x + k < x1);
+      }
+      iterateLanes (zr, zi, cr, ci, valid, maxIter, count);
+
+      int* row = counts + y * width;
+      for (int k = 0; k < L && x + k < x1; k++) row[x + k] = count[k];
+    }
+  }
+}
+
+void Fractal::render (vector<int>& counts, int numThreads) const
+{
+  counts.resize ((size_t) width * height);
+  if (numThreads < 1) numThreads = 1;
+  int tilesX = (width + TILE - 1) / TILE;
+  int tilesY = (height + TILE - 1) / TILE;
+  int numTiles = tilesX * tilesY;
+  atomic<int> nextTile (0);
+
+  auto worker = [&] () {
+    for (;;) {
+      int t = nextTile.fetch_add (1);
+      if (t >= numTiles) break;
+      int x0 = (t % tilesX) * TILE, y0 = (t / tilesX) * TILE;
+      int x1 = min (x0 + TILE, width), y1 = min (y0 + TILE, height);
+      renderTile (counts.data(), x0, y0, x1, y1);
+    }
+  };
+
+  vector<thread> workers;
+  for (int i = 1; i < numThreads; i++) workers.push_back (thread (worker));
+  worker ();
+  for (int i = 0; i < workers.size(); i++) workers[i].join ();
+}
+
+void Fractal::renderScalar (vector<int>& counts) const
+{
+  counts.resize ((size_t) width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      Complex p (left + x * step, top - y * step);
+      Complex z = julia ? p : Complex (0, 0);
+      Complex c = julia ? Complex (juliaRe, juliaIm) : p;
+      int i = 0;
+      while (i < maxIter && z.getMag () <= 2.0) {
+        Complex square = mult (z, z);
+        z = add (square, c);
+        i++;
+      }
+      counts[y * width + x] = i;
+    }
+  }
+}
+
+bool writePGM (const char* filename, const vector<int>& counts,
+               int width, int height, int maxIter)
+{
+  FILE* file = fopen (filename, "wb");
+  if (file == NULL) return false;
+  fprintf (file, "P5\n%d %d\n255\n", width, height);
+
+  // a log scale, so the slow pixels near the boundary stand out; points
+  // that never escape are black
+  vector<unsigned char> row (width);
+  double norm = 255 / log (maxIter + 1.0);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int n = counts[y * width + x];
+      row[x] = (n >= maxIter) ? 0 : (unsigned char) (log (n + 1.0) * norm);
+    }
+    fwrite (row.data(), 1, width, file);
+  }
+  return fclose (file) == 0;
+}
@@ -0,0 +1,51 @@
+#ifndef FRACTAL_H
+#define FRACTAL_H
+#include <vector>
+#include "Complex.h"
+using namespace std;
+
+// Renders the Mandelbrot set (z -> z^2 + c with c the pixel and z
+// starting at 0) or a Julia set (c fixed, z starting at the pixel).
+// Each pixel gets the number of iterations before |z| > 2, or maxIter
+// if it never escapes.
+//
+// The image is cut into square tiles that the threads take one at a
+// time from a shared counter, so a thread that draws cheap tiles
+// outside the set just takes more of them.  Inside a tile LANES pixels
+// are iterated side by side in vector registers (one AVX-512 register
+// or two AVX2 ones, the latter only with FMA too, and a one-lane-at-a-
+// time loop otherwise).  A lane that has escaped is masked off and
+// stops counting, and the group stops as soon as every lane is done.
+class Fractal
+{
+  int width, height, maxIter;
+  double left, top, step;          // the plane coordinates of pixel (0, 0)
+  bool julia;
+  double juliaRe, juliaIm;
+
+public:
+  static const int LANES = 8;
+  static const int TILE = 32;
+
+  // a width x height view of the plane centered at (x, y), scale units
+  // wide
+  Fractal (int width, int height, double x, double y, double scale,
+           int maxIter);
+
+  // iterate z^2 + c with this c for every pixel instead
+  void setJulia (double re, double im);
+
+  int getWidth () const { return width; }
+  int getHeight () const { return height; }
+
+  void render (vector<int>& counts, int numThreads = 1) const;
+  void renderTile (int* counts, int x0, int y0, int x1, int y1) const;
+
+  // one pixel at a time using Complex, for checking
+  void renderScalar (vector<int>& counts) const;
+};
+
+// writes counts as an 8-bit binary PGM, brighter for slower escapes
+bool writePGM (const char* filename, const vector<int>& counts,
+               int width, int height, int maxIter);
+#endif
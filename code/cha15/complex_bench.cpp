@@ -0,0 +1,71 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "Complex.h"
+#include "ComplexArray.h"
+
+// Elementwise add and multiply over a vector<Complex> and over a
+// ComplexArray of the same values.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void report (const char* name, long n, int reps, double t, double check)
+{
+  cout << "  " << name << "\t" << (long) (n * reps / t) << " values/s"
+       << "\t(check " << check << ")" << endl;
+}
+
+int main (int argc, char* argv[])
+{
+  int n = 1000000;
+  if (argc > 1) n = atoi (argv[1]);
+  const int REPS = 20;
+
+  vector<Complex> va (n), vb (n), vout (n);
+  ComplexArray a (n), b (n), out (n);
+  srand (17);
+  for (int i = 0; i < n; i++) {
+    double r1 = rand () / (double) RAND_MAX, i1 = rand () / (double) RAND_MAX;
+    double r2 = rand () / (double) RAND_MAX, i2 = rand () / (double) RAND_MAX;
+    va[i].setCartesian (r1, i1);
+    vb[i].setCartesian (r2, i2);
+    a.setCartesian (i, r1, i1);
+    b.setCartesian (i, r2, i2);
+  }
+
+  cout << n << " values:" << endl;
+  auto start = chrono::steady_clock::now ();
+  for (int r = 0; r < REPS; r++) {
+    for (int i = 0; i < n; i++) vout[i] = add (va[i], vb[i]);
+  }
+  report ("add, vector<Complex>", n, REPS, seconds (start), vout[n/2].getReal ());
+
+  start = chrono::steady_clock::now ();
+  for (int r = 0; r < REPS; r++) add (a, b, out);
+  report ("add, ComplexArray", n, REPS, seconds (start), out.getReal ()[n/2]);
+
+  start = chrono::steady_clock::now ();
+  for (int r = 0; r < REPS; r++) {
+    for (int i = 0; i < n; i++) vout[i] = mult (va[i], vb[i]);
+  }
+  report ("mult, vector<Complex>", n, REPS, seconds (start), vout[n/2].getReal ());
+
+  start = chrono::steady_clock::now ();
+  for (int r = 0; r < REPS; r++) mult (a, b, out);
+  report ("mult, ComplexArray", n, REPS, seconds (start), out.getReal ()[n/2]);
+
+  start = chrono::steady_clock::now ();
+  for (int r = 0; r < REPS; r++) {
+    out.conjugate ();
+    out.scale (0.5);
+  }
+  report ("conj+scale, ComplexArray", n, REPS, seconds (start),
+          out.getReal ()[n/2]);
+  return 0;
+}
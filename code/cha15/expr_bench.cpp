@@ -0,0 +1,113 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "Complex.h"
+#include "ComplexArray.h"
+#include "ComplexExpr.h"
+
+// a*b + c*d and (a + b) * c over Cartesian inputs: with add and mult
+// every product goes through polar form and back, while the
+// expressions pick Cartesian form and do no trig at all.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void report (const char* name, long n, double t, double check)
+{
+  cout << "  " << name << "\t" << (long) (n / t) << " values/s"
+       << "\t(check " << check << ")" << endl;
+}
+
+double random01 () { return rand () / (double) RAND_MAX; }
+
+int main (int argc, char* argv[])
+{
+  int n = 1000000;
+  if (argc > 1) n = atoi (argv[1]);
+
+  srand (17);
+  vector<double> values (8 * n);
+  for (int i = 0; i < values.size(); i++) values[i] = random01 ();
+
+  // the inputs are reset to Cartesian form each time round, so cached
+  // polar forms from the previous round don't help
+  vector<Complex> a (n), b (n), c (n), d (n), out (n);
+  ComplexArray A (n), B (n), C (n), D (n), OUT (n);
+  for (int i = 0; i < n; i++) {
+    A.setCartesian (i, values[8*i], values[8*i+1]);
+    B.setCartesian (i, values[8*i+2], values[8*i+3]);
+    C.setCartesian (i, values[8*i+4], values[8*i+5]);
+    D.setCartesian (i, values[8*i+6], values[8*i+7]);
+  }
+  auto reset = [&] () {
+    for (int i = 0; i < n; i++) {
+      a[i].setCartesian (values[8*i], values[8*i+1]);
+      b[i].setCartesian (values[8*i+2], values[8*i+3]);
+      c[i].setCartesian (values[8*i+4], values[8*i+5]);
+      d[i].setCartesian (values[8*i+6], values[8*i+7]);
+    }
+  };
+
+  cout << "a*b + c*d:" << endl;
+  reset ();
+  auto start = chrono::steady_clock::now ();
+  for (int i = 0; i < n; i++) {
+    Complex p = mult (a[i], b[i]);
+    Complex q = mult (c[i], d[i]);
+    out[i] = add (p, q);
+  }
+  report ("add/mult", n, seconds (start), out[n/2].getReal ());
+
+  reset ();
+  start = chrono::steady_clock::now ();
+  for (int i = 0; i < n; i++) {
+    out[i] = a[i] * b[i] + c[i] * d[i];
+  }
+  report ("expression", n, seconds (start), out[n/2].getReal ());
+
+  start = chrono::steady_clock::now ();
+  evaluate (A * B + C * D, OUT);
+  report ("array, fused", n, seconds (start), OUT.getReal ()[n/2]);
+
+  cout << "(a + b) * c - d:" << endl;
+  reset ();
+  start = chrono::steady_clock::now ();
+  for (int i = 0; i < n; i++) {
+    Complex s = add (a[i], b[i]);
+    Complex p = mult (s, c[i]);
+    Complex m (-d[i].getReal (), -d[i].getImag ());
+    out[i] = add (p, m);
+  }
+  report ("add/mult", n, seconds (start), out[n/2].getReal ());
+
+  reset ();
+  start = chrono::steady_clock::now ();
+  for (int i = 0; i < n; i++) {
+    out[i] = (a[i] + b[i]) * c[i] - d[i];
+  }
+  report ("expression", n, seconds (start), out[n/2].getReal ());
+
+  start = chrono::steady_clock::now ();
+  evaluate ((A + B) * C - D, OUT);
+  report ("array, fused", n, seconds (start), OUT.getReal ()[n/2]);
+
+  cout << "a*b*c on polar inputs:" << endl;
+  for (int i = 0; i < n; i++) {
+    a[i].setPolar (values[8*i], values[8*i+1]);
+    b[i].setPolar (values[8*i+2], values[8*i+3]);
+    c[i].setPolar (values[8*i+4], values[8*i+5]);
+  }
+  start = chrono::steady_clock::now ();
+  for (int i = 0; i < n; i++) {
+    out[i] = a[i] * b[i] * c[i];
+  }
+  report ("expression", n, seconds (start), out[n/2].getMag ());
+  cout << "  (stays polar: " << (out[n/2].isPolar () && !out[n/2].isCartesian ()
+                                  ? "yes" : "no") << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,170 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+#include "FFT.h"
+
+// Checks the FFT against the naive DFT on small sizes, checks the
+// threaded transforms at a size big enough to be split between threads,
+// then times sizes from 2^10 up to 2^maxLog (24 by default).  Each timed
+// transform starts again from the same input (the copy is included in
+// the time), since transforming the output over and over makes it grow
+// until it overflows.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+void randomFill (vector<double>& v)
+{
+  for (int i = 0; i < v.size(); i++) v[i] = rand () / (double) RAND_MAX - 0.5;
+}
+
+double maxError (const vector<double>& a, const vector<double>& b, int n)
+{
+  double worst = 0;
+  for (int i = 0; i < n; i++) {
+    double e = fabs (a[i] - b[i]);
+    if (e > worst) worst = e;
+  }
+  return worst;
+}
+
+void verify (int n)
+{
+  vector<double> re (n), im (n), dr (n), di (n);
+  randomFill (re);
+  randomFill (im);
+  naiveDFT (re.data(), im.data(), dr.data(), di.data(), n);
+
+  FFT fft (n);
+  vector<double> fr = re, fi = im;
+  fft.forward (fr.data(), fi.data());
+  double complexError = max (maxError (fr, dr, n), maxError (fi, di, n));
+
+  fft.inverse (fr.data(), fi.data());
+  double roundTrip = max (maxError (fr, re, n), maxError (fi, im, n));
+
+  vector<double> zero (n, 0.0), rr (n/2 + 1), ri (n/2 + 1);
+  naiveDFT (re.data(), zero.data(), dr.data(), di.data(), n);
+  RealFFT rfft (n);
+  rfft.forward (re.data(), rr.data(), ri.data());
+  double realError = max (maxError (rr, dr, n/2 + 1), maxError (ri, di, n/2 + 1));
+
+  cout << n << "\tcomplex " << complexError << "\treal " << realError
+       << "\tinverse " << roundTrip << endl;
+}
+
+// one bin of the DFT, summed directly
+void dftBin (const vector<double>& re, const vector<double>& im, int k,
+             double& outRe, double& outIm)
+{
+  int n = re.size ();
+  long double sr = 0, si = 0;
+  for (int j = 0; j < n; j++) {
+    long jk = (long) j * k % n;
+    long double a = -2 * M_PI * jk / n;
+    sr += re[j] * cos (a) - im[j] * sin (a);
+    si += re[j] * sin (a) + im[j] * cos (a);
+  }
+  outRe = sr;
+  outIm = si;
+}
+
+// the one-thread transform is spot-checked against single DFT bins,
+// and the threaded transforms must match it
+void verifyThreads (int n)
+{
+  vector<double> re (n), im (n);
+  randomFill (re);
+  randomFill (im);
+  FFT fft (n);
+  RealFFT rfft (n);
+
+  vector<double> fr = re, fi = im;
+  fft.forward (fr.data(), fi.data());
+  double binError = 0;
+  int bins[] = { 0, 1, 7, n/4 + 3, n/2, n - 1 };
+  for (int b = 0; b < 6; b++) {
+    double dr, di;
+    dftBin (re, im, bins[b], dr, di);
+    binError = max (binError, max (fabs (fr[bins[b]] - dr),
+                                   fabs (fi[bins[b]] - di)));
+  }
+  vector<double> rr (n/2 + 1), ri (n/2 + 1);
+  rfft.forward (re.data(), rr.data(), ri.data());
+  cout << n << "\t1 thread\tDFT bins " << binError << endl;
+
+  int counts[] = { 2, 3, 4, 8 };
+  for (int c = 0; c < 4; c++) {
+    int threads = counts[c];
+    vector<double> tr = re, ti = im;
+    fft.forward (tr.data(), ti.data(), threads);
+    double forwardDiff = max (maxError (tr, fr, n), maxError (ti, fi, n));
+    fft.inverse (tr.data(), ti.data(), threads);
+    double roundTrip = max (maxError (tr, re, n), maxError (ti, im, n));
+    vector<double> trr (n/2 + 1), tri (n/2 + 1);
+    rfft.forward (re.data(), trr.data(), tri.data(), threads);
+    double realDiff = max (maxError (trr, rr, n/2 + 1),
+                           maxError (tri, ri, n/2 + 1));
+    cout << n << "\t" << threads << " threads\tvs 1 thread " << forwardDiff
+         << "\treal " << realDiff << "\tinverse " << roundTrip << endl;
+  }
+}
+
+int main (int argc, char* argv[])
+{
+  int maxLog = 24;
+  if (argc > 1) maxLog = atoi (argv[1]);
+  int threads = thread::hardware_concurrency ();
+  if (threads < 1) threads = 1;
+  srand (17);
+
+  cout << "max error against the naive DFT:" << endl;
+  for (int n = 4; n <= 4096; n *= 8) verify (n);
+  verifyThreads (1 << 18);
+
+  cout << "\nsize\t1 thread\t" << threads << " threads\treal input"
+       << "\t(GFLOP/s, 5 n log2 n)" << endl;
+  for (int lg = 10; lg <= maxLog; lg += 2) {
+    int n = 1 << lg;
+    FFT fft (n);
+    RealFFT rfft (n);
+    vector<double> inRe (n), inIm (n), outRe (n/2 + 1), outIm (n/2 + 1);
+    randomFill (inRe);
+    randomFill (inIm);
+    vector<double> re = inRe, im = inIm;
+    int reps = max (1, (1 << 24) / n);
+    double flops = 5.0 * n * lg * reps;
+
+    auto start = chrono::steady_clock::now ();
+    for (int r = 0; r < reps; r++) {
+      re = inRe;
+      im = inIm;
+      fft.forward (re.data(), im.data());
+    }
+    double t1 = seconds (start);
+
+    start = chrono::steady_clock::now ();
+    for (int r = 0; r < reps; r++) {
+      re = inRe;
+      im = inIm;
+      fft.forward (re.data(), im.data(), threads);
+    }
+    double tn = seconds (start);
+
+    start = chrono::steady_clock::now ();
+    for (int r = 0; r < reps; r++) {
+      rfft.forward (inRe.data(), outRe.data(), outIm.data());
+    }
+    double tr = seconds (start);
+
+    cout << "2^" << lg << "\t" << flops / t1 * 1e-9 << "\t\t"
+         << flops / tn * 1e-9 << "\t\t" << flops / tr * 1e-9 << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+#include "Fractal.h"
+
+// Checks the vector kernel against the Complex version, then renders
+// the Mandelbrot set at several zoom levels (and one Julia set) with
+// more and more threads.  The deeper views mix pixels that escape at
+// once with pixels that run to maxIter, so the cost per tile varies a
+// lot.  Each view is saved as fractal<k>.pgm.
+
+struct View {
+  const char* name;
+  double x, y, scale;
+  int maxIter;
+  bool julia;
+};
+
+const View VIEWS[] = {
+  { "whole set",      -0.5,    0.0,    3.0,    256,  false },
+  { "seahorse 1e-2",  -0.743643887037151, 0.131825904205330, 1e-2, 1024, false },
+  { "seahorse 1e-5",  -0.743643887037151, 0.131825904205330, 1e-5, 4096, false },
+  { "seahorse 1e-9",  -0.743643887037151, 0.131825904205330, 1e-9, 8192, false },
+  { "julia",           0.0,    0.0,    3.2,    1024, true  },
+};
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+Fractal makeFractal (const View& v, int w, int h)
+{
+  Fractal f (w, h, v.x, v.y, v.scale, v.maxIter);
+  if (v.julia) f.setJulia (-0.8, 0.156);
+  return f;
+}
+
+int main (int argc, char* argv[])
+{
+  int size = 1024;
+  if (argc > 1) size = atoi (argv[1]);
+  int maxThreads = thread::hardware_concurrency ();
+  if (maxThreads < 1) maxThreads = 1;
+
+  // Complex::mult goes through polar form, so it can round differently
+  // from z*z in Cartesian form and pixels right on the edge may differ
+  // by a few iterations
+  cout << "vector kernel vs Complex (160x120):" << endl;
+  for (const View& v : VIEWS) {
+    Fractal f = makeFractal (v, 160, 120);
+    vector<int> fast, slow;
+    f.render (fast);
+    auto start = chrono::steady_clock::now ();
+    f.renderScalar (slow);
+    double t = seconds (start);
+    int differ = 0;
+    for (int i = 0; i < fast.size(); i++) {
+      if (fast[i] != slow[i]) differ++;
+    }
+    printf ("%-16s %5.2f%% of pixels differ\tComplex: %.3g pixels/s\n",
+            v.name, 100.0 * differ / fast.size(), fast.size() / t);
+  }
+
+  cout << "\nview\t\tthreads\tpixels/s\tspeedup" << endl;
+  for (int k = 0; k < sizeof VIEWS / sizeof VIEWS[0]; k++) {
+    const View& v = VIEWS[k];
+    Fractal f = makeFractal (v, size, size);
+    vector<int> counts;
+    double base = 0;
+    for (int threads = 1; threads <= 2 * maxThreads; threads *= 2) {
+      auto start = chrono::steady_clock::now ();
+      f.render (counts, threads);
+      double rate = (double) size * size / seconds (start);
+      if (threads == 1) base = rate;
+      printf ("%-16s%d\t%.3g\t\t%.2fx\n", v.name, threads, rate, rate / base);
+    }
+    char filename[32];
+    sprintf (filename, "fractal%d.pgm", k);
+    if (!writePGM (filename, counts, size, size, v.maxIter)) {
+      cerr << "could not write " << filename << endl;
+    }
+  }
+  return 0;
+}
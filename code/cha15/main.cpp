@@ -0,0 +1,21 @@
+#include <iostream>
+using namespace std;
+#include "Complex.h"
+
+int main ()
+{
+  Complex c1 (2.0, 3.0);
+  Complex c2 (3.0, 4.0);
+  c1.printCartesian();
+  c1.printPolar();
+  c2.printCartesian();
+  c2.printPolar();
+
+  Complex sum = add (c1, c2);
+  sum.printCartesian();
+
+  Complex product = mult (c1, c2);
+  product.printPolar();
+  product.printCartesian();
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "ComplexArray.h"
+#include "FastMath.h"
+
+// For each accuracy: the worst error against the C library (measured
+// in long double), and the speed of each kernel and of converting a
+// whole ComplexArray.
+
+const char* NAMES[] = { "precise", "medium", "fast" };
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+double random (double low, double high)
+{
+  return low + (high - low) * (rand () / (double) RAND_MAX);
+}
+
+int main (int argc, char* argv[])
+{
+  int n = 1000000;
+  if (argc > 1) n = atoi (argv[1]);
+  const int REPS = 10;
+
+  srand (17);
+  vector<double> angle (n), x (n), y (n), s (n), c (n), out (n);
+  for (int i = 0; i < n; i++) {
+    angle[i] = random (-20, 20);
+    x[i] = random (-10, 10);
+    y[i] = random (-10, 10);
+  }
+
+  cout << "tier\tsincos err\tatan2 err\thypot rel err\t"
+       << "sincos/s\tatan2/s\t\thypot/s\t\tto polar/s\tto cartesian/s" << endl;
+  double base[5];
+  for (int t = 0; t < 3; t++) {
+    Accuracy acc = Accuracy (t);
+
+    fastSinCos (angle.data(), s.data(), c.data(), n, acc);
+    double sinCosErr = 0;
+    for (int i = 0; i < n; i++) {
+      long double a = angle[i];
+      sinCosErr = max (sinCosErr, (double) fabsl (s[i] - sinl (a)));
+      sinCosErr = max (sinCosErr, (double) fabsl (c[i] - cosl (a)));
+    }
+    fastAtan2 (y.data(), x.data(), out.data(), n, acc);
+    double atanErr = 0;
+    for (int i = 0; i < n; i++) {
+      long double e = out[i] - atan2l ((long double) y[i], (long double) x[i]);
+      atanErr = max (atanErr, (double) fabsl (e));
+    }
+    fastHypot (x.data(), y.data(), out.data(), n, acc);
+    double hypotErr = 0;
+    for (int i = 0; i < n; i++) {
+      long double h = hypotl ((long double) x[i], (long double) y[i]);
+      hypotErr = max (hypotErr, (double) fabsl ((out[i] - h) / h));
+    }
+
+    double speed[5];
+    auto start = chrono::steady_clock::now ();
+    for (int r = 0; r < REPS; r++) {
+      fastSinCos (angle.data(), s.data(), c.data(), n, acc);
+    }
+    speed[0] = (double) n * REPS / seconds (start);
+
+    start = chrono::steady_clock::now ();
+    for (int r = 0; r < REPS; r++) {
+      fastAtan2 (y.data(), x.data(), out.data(), n, acc);
+    }
+    speed[1] = (double) n * REPS / seconds (start);
+
+    start = chrono::steady_clock::now ();
+    for (int r = 0; r < REPS; r++) {
+      fastHypot (x.data(), y.data(), out.data(), n, acc);
+    }
+    speed[2] = (double) n * REPS / seconds (start);
+
+    ComplexArray a (n);
+    double* re = a.writeReal ();
+    double* im = a.writeImag ();
+    for (int i = 0; i < n; i++) {
+      re[i] = x[i];  im[i] = y[i];
+    }
+    double toPolar = 0, toCartesian = 0;
+    for (int r = 0; r < REPS; r++) {
+      a.writeReal ();                // only Cartesian is valid now
+      start = chrono::steady_clock::now ();
+      a.calculatePolar (acc);
+      toPolar += seconds (start);
+      a.writeMag ();                 // only polar is valid now
+      start = chrono::steady_clock::now ();
+      a.calculateCartesian (acc);
+      toCartesian += seconds (start);
+    }
+    speed[3] = (double) n * REPS / toPolar;
+    speed[4] = (double) n * REPS / toCartesian;
+    if (t == 0) {
+      for (int k = 0; k < 5; k++) base[k] = speed[k];
+    }
+
+    cout << NAMES[t] << "\t" << sinCosErr << "\t" << atanErr << "\t"
+         << hypotErr;
+    for (int k = 0; k < 5; k++) {
+      cout << "\t" << (long) speed[k] << " (" << speed[k] / base[k] << "x)";
+    }
+    cout << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,477 @@
+#include <immintrin.h>
+#include <cstdint>
+#include <utility>
+#include "Count.h"
+
+// The vector loops count in 32-bit lanes, so they add their lanes up
+// at least this often (in vectors) before a lane could overflow.
+const long FLUSH = 1L << 28;
+
+// above this many values countValues makes a histogram instead of
+// comparing every element against every value
+const int MAX_COMPARED = 16;
+
+// countValues packs the ints into bytes and counts in 8-bit lanes, so
+// it adds its lanes up at least this often (in vectors)
+const long BYTE_FLUSH = 255;
+
+// high - low without signed overflow, as the bits of an int
+static inline int rangeWidth (int low, int high)
+{
+  return (int) ((unsigned) high - (unsigned) low);
+}
+
+// ---- scalar
+
+static long countScalar (span<const int> v, int value)
+{
+  long count = 0;
+  for (size_t i = 0; i < v.size(); i++) count += (v[i] == value);
+  return count;
+}
+
+static long findScalar (span<const int> v, int value)
+{
+  for (size_t i = 0; i < v.size(); i++) {
+    if (v[i] == value) return i;
+  }
+  return -1;
+}
+
+static long countRangeScalar (span<const int> v, int low, int high)
+{
+  if (high < low) return 0;
+  // one unsigned compare checks both ends
+  unsigned width = (unsigned) high - (unsigned) low;
+  long count = 0;
+  for (size_t i = 0; i < v.size(); i++) {
+    count += ((unsigned) v[i] - (unsigned) low <= width);
+  }
+  return count;
+}
+
+static void countValuesScalar (span<const int> v, int numValues, long* counts)
+{
+  for (int k = 0; k < numValues; k++) counts[k] = 0;
+  for (size_t i = 0; i < v.size(); i++) {
+    unsigned x = v[i];
+    if (x < (unsigned) numValues) counts[x]++;
+  }
+}
+
+// counts[k] += how many of the last few elements equal k
+static void addTail (span<const int> v, int numValues, long* counts)
+{
+  for (size_t i = 0; i < v.size(); i++) {
+    unsigned x = v[i];
+    if (x < (unsigned) numValues) counts[x]++;
+  }
+}
+
+// Values::run<K> compares each vector with all K values, and with K
+// fixed at compile time its K accumulators stay in registers; this
+// picks the right K, or a plain histogram when there are too many.
+typedef void (*ValuesKernel) (span<const int>, long*);
+
+template <class Values, int... K>
+static void countValuesWith (span<const int> v, int numValues, long* counts,
+                             integer_sequence<int, K...>)
+{
+  static const ValuesKernel table[] = { &Values::template run<K + 1>... };
+  table[numValues - 1] (v, counts);
+}
+
+template <class Values>
+static void countValuesWith (span<const int> v, int numValues, long* counts)
+{
+  if (numValues < 1) return;
+  if (numValues > MAX_COMPARED) {
+    countValuesScalar (v, numValues, counts);
+    return;
+  }
+  countValuesWith<Values> (v, numValues, counts,
+                           make_integer_sequence<int, MAX_COMPARED> ());
+}
+
+// ---- SSE2, 4 ints at a time
+
+static inline __m128i load4 (const int* p)
+{
+  return _mm_loadu_si128 ((const __m128i*) p);
+}
+
+static long sumLanes (__m128i acc)
+{
+  int lanes[4];
+  _mm_storeu_si128 ((__m128i*) lanes, acc);
+  return (long) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static long countSse2 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0, count = 0;
+  __m128i key = _mm_set1_epi32 (value);
+  while (i + 4 <= n) {
+    long end = i + 4 * FLUSH < n ? i + 4 * FLUSH : n;
+    __m128i acc = _mm_setzero_si128 ();
+    for (; i + 4 <= end; i += 4) {
+      __m128i x = load4 (p + i);
+      acc = _mm_sub_epi32 (acc, _mm_cmpeq_epi32 (x, key));   // -1 if equal
+    }
+    count += sumLanes (acc);
+  }
+  return count + countScalar (v.subspan (i), value);
+}
+
+static long findSse2 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0;
+  __m128i key = _mm_set1_epi32 (value);
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = _mm_cmpeq_epi32 (load4 (p + i), key);
+    __m128i b = _mm_cmpeq_epi32 (load4 (p + i + 4), key);
+    __m128i c = _mm_cmpeq_epi32 (load4 (p + i + 8), key);
+    __m128i d = _mm_cmpeq_epi32 (load4 (p + i + 12), key);
+    __m128i any = _mm_or_si128 (_mm_or_si128 (a, b), _mm_or_si128 (c, d));
+    if (_mm_movemask_epi8 (any)) break;    // it's in these 16
+  }
+  long rest = findScalar (v.subspan (i), value);
+  return rest < 0 ? -1 : i + rest;
+}
+
+static long countRangeSse2 (span<const int> v, int low, int high)
+{
+  if (high < low) return 0;
+  const int* p = v.data();
+  long n = v.size(), i = 0, outside = 0;
+  // SSE2 only compares signed ints, so flip the sign bit to compare
+  // x - low and high - low as unsigned
+  __m128i sign = _mm_set1_epi32 (INT32_MIN);
+  __m128i base = _mm_set1_epi32 (low);
+  __m128i bound = _mm_xor_si128 (_mm_set1_epi32 (rangeWidth (low, high)), sign);
+  while (i + 4 <= n) {
+    long end = i + 4 * FLUSH < n ? i + 4 * FLUSH : n;
+    __m128i acc = _mm_setzero_si128 ();
+    for (; i + 4 <= end; i += 4) {
+      __m128i x = load4 (p + i);
+      x = _mm_xor_si128 (_mm_sub_epi32 (x, base), sign);
+      acc = _mm_sub_epi32 (acc, _mm_cmpgt_epi32 (x, bound));
+    }
+    outside += sumLanes (acc);
+  }
+  return (i - outside) + countRangeScalar (v.subspan (i), low, high);
+}
+
+// the bytes of acc added up
+static long sumBytes (__m128i acc)
+{
+  __m128i sums = _mm_sad_epu8 (acc, _mm_setzero_si128 ());
+  return _mm_cvtsi128_si64 (sums)
+         + _mm_cvtsi128_si64 (_mm_unpackhi_epi64 (sums, sums));
+}
+
+// Four vectors of ints are packed into one vector of 16 bytes with
+// signed saturation, so anything outside -128 to 127 becomes -128 or
+// 127 and still cannot match a value below MAX_COMPARED.  Each compare
+// then checks 16 elements, and the byte order the packs leave does not
+// matter for counting.
+struct Sse2Values {
+  template <int K>
+  static void run (span<const int> v, long* counts) {
+    const int* p = v.data();
+    long n = v.size(), i = 0;
+    for (int k = 0; k < K; k++) counts[k] = 0;
+    while (i + 16 <= n) {
+      long end = i + 16 * BYTE_FLUSH < n ? i + 16 * BYTE_FLUSH : n;
+      __m128i acc[K];
+      for (int k = 0; k < K; k++) acc[k] = _mm_setzero_si128 ();
+      for (; i + 16 <= end; i += 16) {
+        __m128i a = _mm_packs_epi32 (load4 (p + i), load4 (p + i + 4));
+        __m128i b = _mm_packs_epi32 (load4 (p + i + 8), load4 (p + i + 12));
+        __m128i x = _mm_packs_epi16 (a, b);
+        #pragma GCC unroll 16
+        for (int k = 0; k < K; k++) {
+          __m128i key = _mm_set1_epi8 (k);
+          acc[k] = _mm_sub_epi8 (acc[k], _mm_cmpeq_epi8 (x, key));
+        }
+      }
+      for (int k = 0; k < K; k++) counts[k] += sumBytes (acc[k]);
+    }
+    addTail (v.subspan (i), K, counts);
+  }
+};
+
+static void countValuesSse2 (span<const int> v, int numValues, long* counts)
+{
+  countValuesWith<Sse2Values> (v, numValues, counts);
+}
+
+// ---- AVX2, 8 ints at a time
+
+__attribute__ ((target ("avx2")))
+static inline __m256i load8 (const int* p)
+{
+  return _mm256_loadu_si256 ((const __m256i*) p);
+}
+
+__attribute__ ((target ("avx2")))
+static long sumLanes (__m256i acc)
+{
+  __m128i half = _mm_add_epi32 (_mm256_castsi256_si128 (acc),
+                                _mm256_extracti128_si256 (acc, 1));
+  return sumLanes (half);
+}
+
+__attribute__ ((target ("avx2")))
+static long countAvx2 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0, count = 0;
+  __m256i key = _mm256_set1_epi32 (value);
+  while (i + 8 <= n) {
+    long end = i + 8 * FLUSH < n ? i + 8 * FLUSH : n;
+    __m256i acc = _mm256_setzero_si256 ();
+    for (; i + 8 <= end; i += 8) {
+      __m256i x = load8 (p + i);
+      acc = _mm256_sub_epi32 (acc, _mm256_cmpeq_epi32 (x, key));
+    }
+    count += sumLanes (acc);
+  }
+  return count + countScalar (v.subspan (i), value);
+}
+
+__attribute__ ((target ("avx2")))
+static long findAvx2 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0;
+  __m256i key = _mm256_set1_epi32 (value);
+  for (; i + 32 <= n; i += 32) {
+    __m256i a = _mm256_cmpeq_epi32 (load8 (p + i), key);
+    __m256i b = _mm256_cmpeq_epi32 (load8 (p + i + 8), key);
+    __m256i c = _mm256_cmpeq_epi32 (load8 (p + i + 16), key);
+    __m256i d = _mm256_cmpeq_epi32 (load8 (p + i + 24), key);
+    __m256i any = _mm256_or_si256 (_mm256_or_si256 (a, b),
+                                   _mm256_or_si256 (c, d));
+    if (!_mm256_testz_si256 (any, any)) break;
+  }
+  long rest = findScalar (v.subspan (i), value);
+  return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__ ((target ("avx2")))
+static long countRangeAvx2 (span<const int> v, int low, int high)
+{
+  if (high < low) return 0;
+  const int* p = v.data();
+  long n = v.size(), i = 0, inside = 0;
+  // x - low <= high - low as unsigned is max (x - low, width) == width
+  __m256i base = _mm256_set1_epi32 (low);
+  __m256i width = _mm256_set1_epi32 (rangeWidth (low, high));
+  while (i + 8 <= n) {
+    long end = i + 8 * FLUSH < n ? i + 8 * FLUSH : n;
+    __m256i acc = _mm256_setzero_si256 ();
+    for (; i + 8 <= end; i += 8) {
+      __m256i x = _mm256_sub_epi32 (load8 (p + i), base);
+      __m256i in = _mm256_cmpeq_epi32 (_mm256_min_epu32 (x, width), x);
+      acc = _mm256_sub_epi32 (acc, in);
+    }
+    inside += sumLanes (acc);
+  }
+  return inside + countRangeScalar (v.subspan (i), low, high);
+}
+
+// the eight bytes of each 64-bit lane added up, then the lanes
+__attribute__ ((target ("avx2")))
+static long sumBytes (__m256i acc)
+{
+  __m256i sums = _mm256_sad_epu8 (acc, _mm256_setzero_si256 ());
+  __m128i half = _mm_add_epi64 (_mm256_castsi256_si128 (sums),
+                                _mm256_extracti128_si256 (sums, 1));
+  return _mm_cvtsi128_si64 (half) + _mm_extract_epi64 (half, 1);
+}
+
+// as Sse2Values, with 32 elements to a compare
+struct Avx2Values {
+  template <int K>
+  __attribute__ ((target ("avx2")))
+  static void run (span<const int> v, long* counts) {
+    const int* p = v.data();
+    long n = v.size(), i = 0;
+    for (int k = 0; k < K; k++) counts[k] = 0;
+    while (i + 32 <= n) {
+      long end = i + 32 * BYTE_FLUSH < n ? i + 32 * BYTE_FLUSH : n;
+      __m256i acc[K];
+      for (int k = 0; k < K; k++) acc[k] = _mm256_setzero_si256 ();
+      for (; i + 32 <= end; i += 32) {
+        __m256i a = _mm256_packs_epi32 (load8 (p + i), load8 (p + i + 8));
+        __m256i b = _mm256_packs_epi32 (load8 (p + i + 16),
+                                        load8 (p + i + 24));
+        __m256i x = _mm256_packs_epi16 (a, b);
+        #pragma GCC unroll 16
+        for (int k = 0; k < K; k++) {
+          __m256i key = _mm256_set1_epi8 (k);
+          acc[k] = _mm256_sub_epi8 (acc[k], _mm256_cmpeq_epi8 (x, key));
+        }
+      }
+      for (int k = 0; k < K; k++) counts[k] += sumBytes (acc[k]);
+    }
+    addTail (v.subspan (i), K, counts);
+  }
+};
+
+static void countValuesAvx2 (span<const int> v, int numValues, long* counts)
+{
+  countValuesWith<Avx2Values> (v, numValues, counts);
+}
+
+// ---- AVX-512, 16 ints at a time; compares give bit masks, so counts
+// are popcounts and nothing can overflow (except in countValues, which
+// counts in bytes)
+
+__attribute__ ((target ("avx512f")))
+static inline __m512i load16 (const int* p)
+{
+  return _mm512_loadu_si512 (p);
+}
+
+__attribute__ ((target ("avx512f,popcnt")))
+static long countAvx512 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0, count = 0;
+  __m512i key = _mm512_set1_epi32 (value);
+  for (; i + 16 <= n; i += 16) {
+    __m512i x = load16 (p + i);
+    count += _mm_popcnt_u32 (_mm512_cmpeq_epi32_mask (x, key));
+  }
+  return count + countScalar (v.subspan (i), value);
+}
+
+__attribute__ ((target ("avx512f")))
+static long findAvx512 (span<const int> v, int value)
+{
+  const int* p = v.data();
+  long n = v.size(), i = 0;
+  __m512i key = _mm512_set1_epi32 (value);
+  for (; i + 64 <= n; i += 64) {
+    __mmask16 a = _mm512_cmpeq_epi32_mask (load16 (p + i), key);
+    __mmask16 b = _mm512_cmpeq_epi32_mask (load16 (p + i + 16), key);
+    __mmask16 c = _mm512_cmpeq_epi32_mask (load16 (p + i + 32), key);
+    __mmask16 d = _mm512_cmpeq_epi32_mask (load16 (p + i + 48), key);
+    if (a | b | c | d) break;
+  }
+  long rest = findScalar (v.subspan (i), value);
+  return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__ ((target ("avx512f,popcnt")))
+static long countRangeAvx512 (span<const int> v, int low, int high)
+{
+  if (high < low) return 0;
+  const int* p = v.data();
+  long n = v.size(), i = 0, count = 0;
+  __m512i base = _mm512_set1_epi32 (low);
+  __m512i width = _mm512_set1_epi32 (rangeWidth (low, high));
+  for (; i + 16 <= n; i += 16) {
+    __m512i x = _mm512_sub_epi32 (load16 (p + i), base);
+    count += _mm_popcnt_u32 (_mm512_cmple_epu32_mask (x, width));
+  }
+  return count + countRangeScalar (v.subspan (i), low, high);
+}
+
+__attribute__ ((target ("avx512f,avx512bw")))
+static long sumBytes (__m512i acc)
+{
+  return _mm512_reduce_add_epi64 (_mm512_sad_epu8 (acc,
+                                                   _mm512_setzero_si512 ()));
+}
+
+// as Sse2Values, with 64 elements to a compare; the byte compares need
+// AVX-512BW, and without it countValues uses the AVX2 version
+struct Avx512Values {
+  template <int K>
+  __attribute__ ((target ("avx512f,avx512bw")))
+  static void run (span<const int> v, long* counts) {
+    const int* p = v.data();
+    long n = v.size(), i = 0;
+    for (int k = 0; k < K; k++) counts[k] = 0;
+    __m512i one = _mm512_set1_epi8 (1);
+    while (i + 64 <= n) {
+      long end = i + 64 * BYTE_FLUSH < n ? i + 64 * BYTE_FLUSH : n;
+      __m512i acc[K];
+      for (int k = 0; k < K; k++) acc[k] = _mm512_setzero_si512 ();
+      for (; i + 64 <= end; i += 64) {
+        __m512i a = _mm512_packs_epi32 (load16 (p + i), load16 (p + i + 16));
+        __m512i b = _mm512_packs_epi32 (load16 (p + i + 32),
+                                        load16 (p + i + 48));
+        __m512i x = _mm512_packs_epi16 (a, b);
+        #pragma GCC unroll 16
+        for (int k = 0; k < K; k++) {
+          __mmask64 hit = _mm512_cmpeq_epi8_mask (x, _mm512_set1_epi8 (k));
+          acc[k] = _mm512_mask_add_epi8 (acc[k], hit, acc[k], one);
+        }
+      }
+      for (int k = 0; k < K; k++) counts[k] += sumBytes (acc[k]);
+    }
+    addTail (v.subspan (i), K, counts);
+  }
+};
+
+static void countValuesAvx512 (span<const int> v, int numValues,
+                               long* counts)
+{
+  static bool hasBw = __builtin_cpu_supports ("avx512bw");
+  if (hasBw) countValuesWith<Avx512Values> (v, numValues, counts);
+  else countValuesWith<Avx2Values> (v, numValues, counts);
+}
+
+// ---- dispatch
+
+static const CountKernels KERNELS[] = {
+  { SCALAR, "scalar", countScalar, findScalar, countRangeScalar,
+    countValuesScalar },
+  { SSE2, "sse2", countSse2, findSse2, countRangeSse2, countValuesSse2 },
+  { AVX2, "avx2", countAvx2, findAvx2, countRangeAvx2, countValuesAvx2 },
+  { AVX512, "avx512", countAvx512, findAvx512, countRangeAvx512,
+    countValuesAvx512 },
+};
+
+Isa bestIsa ()
+{
+  static Isa best = [] () {
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx512f")) return AVX512;
+    if (__builtin_cpu_supports ("avx2")) return AVX2;
+    if (__builtin_cpu_supports ("sse2")) return SSE2;
+    return SCALAR;
+  } ();
+  return best;
+}
+
+const CountKernels& countKernels (Isa isa)
+{
+  return KERNELS[isa];
+}
+
+long countValue (span<const int> v, int value)
+{
+  return KERNELS[bestIsa ()].count (v, value);
+}
+
+long findValue (span<const int> v, int value)
+{
+  return KERNELS[bestIsa ()].find (v, value);
+}
+
+long countInRange (span<const int> v, int low, int high)
+{
+  return KERNELS[bestIsa ()].countRange (v, low, high);
+}
+
+void countValues (span<const int> v, int numValues, long* counts)
+{
+  KERNELS[bestIsa ()].countValues (v, numValues, counts);
+}
@@ -0,0 +1,40 @@
+#ifndef COUNT_H
+#define COUNT_H
+#include <span>
+using namespace std;
+
+// Counting and searching kernels for arrays of ints, in versions for
+// each generation of x86 vector instructions.  The first call checks
+// what the processor supports and every later call goes straight to
+// the widest version it can run.  They take a span, so a vector (or
+// part of one) is passed without being copied.
+
+enum Isa { SCALAR, SSE2, AVX2, AVX512 };
+
+// how many elements equal value
+long countValue (span<const int> v, int value);
+
+// the index of the first element equal to value, or -1
+long findValue (span<const int> v, int value);
+
+// how many elements are between low and high, inclusive
+long countInRange (span<const int> v, int low, int high);
+
+// counts[k] = how many elements equal k, for k from 0 to numValues-1,
+// all in one pass over v; other elements are not counted
+void countValues (span<const int> v, int numValues, long* counts);
+
+// one set of kernels, for comparing the versions
+struct CountKernels {
+  Isa isa;
+  const char* name;
+  long (*count) (span<const int>, int);
+  long (*find) (span<const int>, int);
+  long (*countRange) (span<const int>, int, int);
+  void (*countValues) (span<const int>, int, long*);
+};
+
+// the widest version this processor can run
+Isa bestIsa ();
+const CountKernels& countKernels (Isa isa);
+#endif
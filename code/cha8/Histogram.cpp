@@ -0,0 +1,132 @@
+#include <iostream>
+#include <atomic>
+#include <cmath>
+#include <stdlib.h>
+#include <thread>
+#include "Histogram.h"
+
+BinEdges::BinEdges (Scale s, double lo, double hi, int n)
+{
+  if (n < 1 || !(hi > lo) || (s == LOG && !(lo > 0))) {
+    cout << "BinEdges needs numBins >= 1, high > low, and low > 0 for LOG"
+         << " (low " << lo << ", high " << hi << ", numBins " << n << ")"
+         << endl;
+    exit (1);
+  }
+  scale = s;
+  low = lo;  high = hi;
+  numBins = n;
+  if (scale == LOG) {
+    offset = log (low);
+    factor = numBins / (log (high) - offset);
+  } else {
+    offset = low;
+    factor = numBins / (high - low);
+  }
+}
+
+int BinEdges::bin (double x) const
+{
+  double t = (scale == LOG) ? log (x) : x;
+  double b = (t - offset) * factor;
+  // clamp in floating point first, so huge values don't overflow int;
+  // NaN ends up in bin 0
+  if (!(b >= 0)) return 0;
+  if (b >= numBins) return numBins - 1;
+  return (int) b;
+}
+
+double BinEdges::lowerEdge (int b) const
+{
+  double t = offset + b / factor;
+  return (scale == LOG) ? exp (t) : t;
+}
+
+Histogram::Histogram (const BinEdges& e) : edges (e), counts (e.numBins, 0)
+{
+}
+
+Strategy Histogram::choose (int numThreads) const
+{
+  long bytes = (long) edges.numBins * sizeof (uint64_t);
+  if (edges.numBins <= FEW_BINS) return SUBHISTOGRAM;
+  if (numThreads > 1 && bytes > CACHE_BYTES) return ATOMIC;
+  return PRIVATE;
+}
+
+// runs work (t) on threads 0 to numThreads - 1 and waits for them
+template <class Work>
+static void parallel (int numThreads, Work work)
+{
+  vector<thread> threads;
+  for (int t = 1; t < numThreads; t++) threads.push_back (thread (work, t));
+  work (0);
+  for (int t = 0; t < threads.size(); t++) threads[t].join ();
+}
+
+void Histogram::fill (const double* samples, long n, int numThreads,
+                      Strategy strategy)
+{
+  if (numThreads < 1) numThreads = 1;
+  if (strategy == AUTOMATIC) strategy = choose (numThreads);
+  int numBins = edges.numBins;
+  const BinEdges e = edges;
+
+  if (strategy == ATOMIC) {
+    vector<atomic<uint64_t> > shared (numBins);
+    for (int b = 0; b < numBins; b++) shared[b].store (0);
+    parallel (numThreads, [&] (int t) {
+      long first = n * t / numThreads, last = n * (t + 1) / numThreads;
+      for (long i = first; i < last; i++) {
+        shared[e.bin (samples[i])].fetch_add (1, memory_order_relaxed);
+      }
+    });
+    for (int b = 0; b < numBins; b++) counts[b] += shared[b].load ();
+    return;
+  }
+
+  // one private block of bins per thread, or SUBS of them
+  int copies = (strategy == SUBHISTOGRAM) ? SUBS : 1;
+  long stride = (long) numBins * copies;
+  vector<uint64_t> local (stride * numThreads, 0);
+
+  parallel (numThreads, [&] (int t) {
+    long first = n * t / numThreads, last = n * (t + 1) / numThreads;
+    uint64_t* mine = local.data() + stride * t;
+    if (copies == 1) {
+      for (long i = first; i < last; i++) mine[e.bin (samples[i])]++;
+      return;
+    }
+    long i = first;
+    for (; i + SUBS <= last; i += SUBS) {
+      for (int k = 0; k < SUBS; k++) {
+        mine[k * numBins + e.bin (samples[i + k])]++;
+      }
+    }
+    for (; i < last; i++) mine[e.bin (samples[i])]++;
+  });
+
+  // each thread sums a slice of the bins over every copy
+  parallel (numThreads, [&] (int t) {
+    int first = (int) ((long) numBins * t / numThreads);
+    int last = (int) ((long) numBins * (t + 1) / numThreads);
+    for (long c = 0; c < (long) numThreads * copies; c++) {
+      const uint64_t* copy = local.data() + c * numBins;
+      for (int b = first; b < last; b++) counts[b] += copy[b];
+    }
+  });
+}
+
+uint64_t Histogram::total () const
+{
+  uint64_t sum = 0;
+  for (int b = 0; b < counts.size(); b++) sum += counts[b];
+  return sum;
+}
+
+void Histogram::print () const
+{
+  for (int b = 0; b < counts.size(); b++) {
+    cout << edges.lowerEdge (b) << "\t" << counts[b] << endl;
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+// Where the bin boundaries go.  UNIFORM bins all have the same width;
+// LOG bins have the same ratio high/low, so they can cover values over
+// many orders of magnitude (low must then be positive).  Values below
+// low count in the first bin and values from high up in the last.
+// The constructor stops the program unless there is at least one bin
+// and high is above low.
+enum Scale { UNIFORM, LOG };
+
+struct BinEdges {
+  Scale scale;
+  double low, high;
+  int numBins;
+  double factor;      // bins per unit (of the value, or of its log)
+  double offset;      // low, or log(low)
+
+  BinEdges (Scale scale, double low, double high, int numBins);
+
+  int bin (double x) const;
+  double lowerEdge (int bin) const;
+};
+
+// How the threads share the work of filling the counts:
+//   PRIVATE     each thread counts into its own bins, and the copies
+//               are summed in parallel at the end
+//   SUBHISTOGRAM  like PRIVATE, but each thread keeps SUBS interleaved
+//               copies and sends consecutive samples to different
+//               copies, so repeated hits on one bin don't each wait
+//               for the previous increment's store; best for few bins
+//   ATOMIC      one shared set of bins with atomic increments; used
+//               when a private copy per thread would not fit in cache
+//   AUTOMATIC   chooses one of the above from the bin count
+enum Strategy { AUTOMATIC, PRIVATE, SUBHISTOGRAM, ATOMIC };
+
+struct Histogram {
+  static const int SUBS = 4;
+  // above this many bytes of private bins per thread, go atomic
+  static const long CACHE_BYTES = 1 << 20;
+  static const int FEW_BINS = 256;
+
+  BinEdges edges;
+  vector<uint64_t> counts;
+
+  Histogram (const BinEdges& edges);
+
+  // adds n samples, split between numThreads threads
+  void fill (const double* samples, long n, int numThreads = 1,
+             Strategy strategy = AUTOMATIC);
+
+  Strategy choose (int numThreads) const;
+  uint64_t total () const;
+  void print () const;
+};
+#endif
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <stdlib.h>
+#include "Quantile.h"
+
+QuantileSketch::QuantileSketch (int p)
+{
+  if (p < 1 || p > MAX_PRECISION) {
+    cout << "QuantileSketch precision must be 1 to " << MAX_PRECISION
+         << ", not " << p << endl;
+    exit (1);
+  }
+  precision = p;
+  int half = 1 << (precision - 1);
+  // enough buckets for the largest int64_t
+  counts.resize ((65 - precision) * half, 0);
+  clear ();
+}
+
+void QuantileSketch::clear ()
+{
+  for (size_t b = 0; b < counts.size(); b++) counts[b] = 0;
+  total = 0;
+  sum = 0;
+  minValue = INT64_MAX;
+  maxValue = 0;
+}
+
+void QuantileSketch::add (const int64_t* values, long n)
+{
+  int64_t lo = minValue, hi = maxValue;
+  double s = 0;
+  uint64_t* c = counts.data();
+  for (long i = 0; i < n; i++) {
+    int64_t v = values[i] < 0 ? 0 : values[i];
+    c[bucket (v)]++;
+    s += v;
+    lo = v < lo ? v : lo;
+    hi = v > hi ? v : hi;
+  }
+  total += n;
+  sum += s;
+  minValue = lo;
+  maxValue = hi;
+}
+
+bool QuantileSketch::merge (const QuantileSketch& other)
+{
+  if (other.precision != precision) return false;
+  for (size_t b = 0; b < counts.size(); b++) counts[b] += other.counts[b];
+  total += other.total;
+  sum += other.sum;
+  if (other.minValue < minValue) minValue = other.minValue;
+  if (other.maxValue > maxValue) maxValue = other.maxValue;
+  return true;
+}
+
+int64_t QuantileSketch::lowest (int b) const
+{
+  int half = 1 << (precision - 1);
+  if (b < 2 * half) return b;
+  int shift = b / half - 1;
+  int64_t mantissa = b - shift * half;
+  return mantissa << shift;
+}
+
+int64_t QuantileSketch::highest (int b) const
+{
+  int half = 1 << (precision - 1);
+  if (b < 2 * half) return b;
+  int shift = b / half - 1;
+  return lowest (b) + ((int64_t) 1 << shift) - 1;
+}
+
+int64_t QuantileSketch::quantile (double q) const
+{
+  if (total == 0) return 0;
+  // the rank of the value wanted, counting from 1
+  uint64_t rank = (uint64_t) ceil (q * total);
+  if (rank < 1) rank = 1;
+  if (rank > total) rank = total;
+
+  uint64_t seen = 0;
+  for (size_t b = 0; b < counts.size(); b++) {
+    seen += counts[b];
+    if (seen >= rank) {
+      int64_t lo = lowest (b), hi = highest (b);
+      int64_t mid = lo + (hi - lo) / 2;
+      if (mid < minValue) mid = minValue;
+      if (mid > maxValue) mid = maxValue;
+      return mid;
+    }
+  }
+  return maxValue;
+}
+
+void QuantileSketch::write (ostream& out) const
+{
+  uint64_t used = 0;
+  for (size_t b = 0; b < counts.size(); b++) used += (counts[b] != 0);
+  out.write ((const char*) &precision, sizeof precision);
+  out.write ((const char*) &total, sizeof total);
+  out.write ((const char*) &minValue, sizeof minValue);
+  out.write ((const char*) &maxValue, sizeof maxValue);
+  out.write ((const char*) &sum, sizeof sum);
+  out.write ((const char*) &used, sizeof used);
+  for (uint32_t b = 0; b < counts.size(); b++) {
+    if (counts[b] == 0) continue;
+    out.write ((const char*) &b, sizeof b);
+    out.write ((const char*) &counts[b], sizeof counts[b]);
+  }
+}
+
+bool QuantileSketch::read (istream& in)
+{
+  int p;
+  uint64_t used;
+  if (!in.read ((char*) &p, sizeof p) || p < 1 || p > MAX_PRECISION) return false;
+  *this = QuantileSketch (p);
+  in.read ((char*) &total, sizeof total);
+  in.read ((char*) &minValue, sizeof minValue);
+  in.read ((char*) &maxValue, sizeof maxValue);
+  in.read ((char*) &sum, sizeof sum);
+  in.read ((char*) &used, sizeof used);
+  for (uint64_t i = 0; i < used && in; i++) {
+    uint32_t b;
+    uint64_t count;
+    in.read ((char*) &b, sizeof b);
+    in.read ((char*) &count, sizeof count);
+    if (!in || b >= counts.size()) return false;
+    counts[b] = count;
+  }
+  return (bool) in;
+}
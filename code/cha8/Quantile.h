@@ -0,0 +1,65 @@
+#ifndef QUANTILE_H
+#define QUANTILE_H
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Approximate percentiles of a stream of non-negative integers (such as
+// latencies) in a fixed amount of memory, in the style of an HDR
+// histogram.  Values below 2^precision each get their own bucket.
+// Above that, every power of two is split into 2^(precision-1) buckets
+// of equal width, so a bucket is never wider than 2^-(precision-1)
+// times the values in it.  Quantiles are reported as the middle of
+// their bucket, off by at most 2^-precision of the true value.  With
+// the default precision of 7 that is under 0.8%, and the whole sketch
+// is about 3800 counters however many values go in.
+//
+// Two sketches with the same precision merge by adding their counters,
+// so threads or processes can each keep one and combine them later;
+// write and read move a sketch through a stream.  precision runs from
+// 1 to MAX_PRECISION; the constructor stops the program otherwise.
+const int MAX_PRECISION = 16;
+
+struct QuantileSketch {
+  int precision;
+  vector<uint64_t> counts;
+  uint64_t total;
+  int64_t minValue, maxValue;
+  double sum;
+
+  QuantileSketch (int precision = 7);
+
+  // negative values are counted as 0
+  void add (int64_t value) {
+    if (value < 0) value = 0;
+    counts[bucket (value)]++;
+    total++;
+    sum += value;
+    if (value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+  }
+  void add (const int64_t* values, long n);
+  // false, and nothing changed, if the precisions differ
+  bool merge (const QuantileSketch& other);
+  void clear ();
+
+  // q between 0 and 1; 0 if nothing has been added
+  int64_t quantile (double q) const;
+  double mean () const { return total ? sum / total : 0; }
+  size_t bytes () const { return sizeof (*this) + counts.size() * 8; }
+
+  int bucket (int64_t value) const {
+    uint64_t v = value;
+    if (v < (1ULL << precision)) return (int) v;
+    int shift = 63 - __builtin_clzll (v) - precision + 1;
+    return (shift << (precision - 1)) + (int) (v >> shift);
+  }
+  int64_t lowest (int bucket) const;
+  int64_t highest (int bucket) const;
+
+  // only the non-empty buckets are written
+  void write (ostream& out) const;
+  bool read (istream& in);
+};
+#endif
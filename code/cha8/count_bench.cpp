@@ -0,0 +1,136 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+using namespace std;
+#include "Count.h"
+
+// Checks every kernel the processor can run against the scalar ones on
+// odd sizes, then times them on n ints (100 million by default) from 0
+// to 9, like the vectors in histogram.cpp.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+// howMany as histogram.cpp first had it, copying the vector
+int howManyByValue (vector<int> vec, int value) {
+  int count = 0;
+  for (int i=0; i< vec.size(); i++) {
+    if (vec[i] == value) count++;
+  }
+  return count;
+}
+
+int howMany (const vector<int>& vec, int value) {
+  int count = 0;
+  for (int i=0; i< vec.size(); i++) {
+    if (vec[i] == value) count++;
+  }
+  return count;
+}
+
+bool check (const CountKernels& k)
+{
+  const CountKernels& ref = countKernels (SCALAR);
+  for (int n = 0; n < 300; n += 1 + n / 8) {
+    vector<int> v (n);
+    for (int i = 0; i < n; i++) v[i] = random () % 24 - 4;
+    if (n > 10) v[n / 3] = INT32_MIN;
+    if (n > 20) v[n / 2] = 256 + 3;       // 3 if cut down to a byte
+    if (n > 40) v[n / 4] = INT32_MAX;
+    span<const int> s (v);
+    for (int value = -5; value < 21; value++) {
+      if (k.count (s, value) != ref.count (s, value)) return false;
+      if (k.find (s, value) != ref.find (s, value)) return false;
+      if (k.countRange (s, value, value + 5) != ref.countRange (s, value, value + 5)) {
+        return false;
+      }
+    }
+    if (k.countRange (s, INT32_MIN, INT32_MAX) != n) return false;
+    if (k.countRange (s, 3, 2) != 0) return false;
+    for (int numValues : { 1, 10, 16, 20 }) {
+      long got[20], want[20];
+      k.countValues (s, numValues, got);
+      ref.countValues (s, numValues, want);
+      for (int j = 0; j < numValues; j++) {
+        if (got[j] != want[j]) return false;
+      }
+    }
+  }
+  // long enough for the byte counters in countValues to be added up
+  // several times, all of them in one counter
+  vector<int> zeros (40007, 0);
+  long got[10], want[10];
+  k.countValues (zeros, 10, got);
+  ref.countValues (zeros, 10, want);
+  for (int j = 0; j < 10; j++) {
+    if (got[j] != want[j]) return false;
+  }
+  return true;
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 100000000;
+  if (argc > 1) n = atol (argv[1]);
+
+  srandom (17);
+  Isa best = bestIsa ();
+  cout << "best isa: " << countKernels (best).name << endl;
+  for (int isa = SSE2; isa <= best; isa++) {
+    const CountKernels& k = countKernels ((Isa) isa);
+    cout << k.name << " matches scalar: " << (check (k) ? "yes" : "NO")
+         << endl;
+  }
+
+  vector<int> vec (n);
+  for (long i = 0; i < n; i++) vec[i] = random () % 10;
+  vec[n - 5] = 42;              // the one find has to get to
+  span<const int> s (vec);
+
+  printf ("\nmillions of ints/s\tcount\tfind\trange\t10 values\n");
+  auto start = chrono::steady_clock::now ();
+  long byValue = howManyByValue (vec, 7);
+  double t = seconds (start);
+  printf ("howMany by value\t%.0f\n", n / t / 1e6);
+
+  start = chrono::steady_clock::now ();
+  long byRef = howMany (vec, 7);
+  t = seconds (start);
+  start = chrono::steady_clock::now ();
+  long tenCounts[10];
+  for (int v = 0; v < 10; v++) tenCounts[v] = howMany (vec, v);
+  double tTen = seconds (start);
+  printf ("howMany by ref\t\t%.0f\t\t\t%.0f\n", n / t / 1e6, n / tTen / 1e6);
+
+  for (int isa = SCALAR; isa <= best; isa++) {
+    const CountKernels& k = countKernels ((Isa) isa);
+    start = chrono::steady_clock::now ();
+    long c = k.count (s, 7);
+    double tCount = seconds (start);
+    start = chrono::steady_clock::now ();
+    long f = k.find (s, 42);
+    double tFind = seconds (start);
+    start = chrono::steady_clock::now ();
+    long r = k.countRange (s, 3, 6);
+    double tRange = seconds (start);
+    long counts[10];
+    start = chrono::steady_clock::now ();
+    k.countValues (s, 10, counts);
+    double tValues = seconds (start);
+
+    bool ok = (c == byRef && c == byValue && f == n - 5 &&
+               r == tenCounts[3] + tenCounts[4] + tenCounts[5] + tenCounts[6]);
+    for (int v = 0; v < 10; v++) {
+      if (counts[v] != tenCounts[v]) ok = false;
+    }
+    printf ("%s\t\t\t%.0f\t%.0f\t%.0f\t%.0f%s\n", k.name, n / tCount / 1e6,
+            n / tFind / 1e6, n / tRange / 1e6, n / tValues / 1e6,
+            ok ? "" : "\tWRONG");
+  }
+  return 0;
+}
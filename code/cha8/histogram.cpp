@@ -10,13 +10,13 @@ vector<int> randomVector (int n) {
   return vec;
 }
 
-void printVector (vector<int> vec) {
+void printVector (const vector<int>& vec) {
   for (int i = 0; i<vec.size(); i++) {
     cout << vec[i];
   }
 }
 
-int howMany (vector<int> vec, int value) {
+int howMany (const vector<int>& vec, int value) {
   int count = 0;
   for (int i=0; i< vec.size(); i++) {
     if (vec[i] == value) count++;
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+using namespace std;
+#include "Histogram.h"
+
+// Fills histograms from 10 up to 16 million bins with each strategy
+// on 1 to 64 threads, and reports samples per second.  Every run has
+// to produce the same counts as the first one for its bins.
+
+const char* STRATEGY_NAMES[] = { "auto", "private", "subhist", "atomic" };
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+struct Config {
+  Scale scale;
+  double low, high;
+  int numBins;
+};
+
+int main (int argc, char* argv[])
+{
+  long n = 20000000;
+  if (argc > 1) n = atol (argv[1]);
+
+  // uniform digits like histogram.cpp, and log-normal "latencies"
+  mt19937_64 rng (17);
+  vector<double> uniform (n), latency (n);
+  uniform_real_distribution<double> digits (0, 10);
+  lognormal_distribution<double> spread (0, 2);
+  for (long i = 0; i < n; i++) {
+    uniform[i] = digits (rng);
+    latency[i] = spread (rng);
+  }
+
+  Config configs[] = {
+    { UNIFORM, 0, 10, 10 },
+    { LOG, 1e-4, 1e4, 1000 },
+    { LOG, 1e-4, 1e4, 1000000 },
+    { LOG, 1e-4, 1e4, 16000000 },
+  };
+
+  printf ("%ld samples; millions of samples/s by thread count\n\n", n);
+  printf ("bins\t\tstrategy");
+  for (int threads = 1; threads <= 64; threads *= 2) printf ("\t%d", threads);
+  printf ("\n");
+
+  for (const Config& c : configs) {
+    BinEdges edges (c.scale, c.low, c.high, c.numBins);
+    const double* samples = (c.scale == UNIFORM) ? uniform.data()
+                                                 : latency.data();
+    vector<uint64_t> reference;
+    for (int s = PRIVATE; s <= ATOMIC; s++) {
+      Strategy strategy = (Strategy) s;
+      if (strategy == SUBHISTOGRAM && c.numBins > 65536) continue;
+      printf ("%-8d %s\t%s", c.numBins, c.scale == LOG ? "log" : "uni",
+              STRATEGY_NAMES[s]);
+      for (int threads = 1; threads <= 64; threads *= 2) {
+        // private copies of the biggest histograms don't fit in memory
+        double bytes = (double) c.numBins * 8 * threads
+                       * (strategy == SUBHISTOGRAM ? Histogram::SUBS : 1);
+        if (strategy != ATOMIC && bytes > 1e9) {
+          printf ("\t-");
+          continue;
+        }
+        Histogram h (edges);
+        auto start = chrono::steady_clock::now ();
+        h.fill (samples, n, threads, strategy);
+        double t = seconds (start);
+        bool ok = h.total () == n;
+        if (reference.empty ()) reference = h.counts;
+        if (h.counts != reference) ok = false;
+        printf ("\t%.0f%s", n / t / 1e6, ok ? "" : "!");
+        fflush (stdout);
+      }
+      printf ("\n");
+    }
+    Histogram h (edges);
+    printf ("  automatic picks %s on 1 thread, %s on 8\n",
+            STRATEGY_NAMES[h.choose (1)], STRATEGY_NAMES[h.choose (8)]);
+  }
+
+  cout << "\nthe digits of histogram.cpp:" << endl;
+  Histogram digitsHist (BinEdges (UNIFORM, 0, 10, 10));
+  digitsHist.fill (uniform.data(), n, 4);
+  digitsHist.print ();
+  return 0;
+}
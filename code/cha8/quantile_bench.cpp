@@ -0,0 +1,103 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+using namespace std;
+#include "Quantile.h"
+
+// Feeds n log-normal "latencies" in nanoseconds (50 million by default)
+// into sketches, one per thread, merges them, and compares p50, p99 and
+// p99.9 with the exact values from sorting everything.  Also reports
+// the memory each approach needs and how fast values go in.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+int main (int argc, char* argv[])
+{
+  long n = 50000000;
+  if (argc > 1) n = atol (argv[1]);
+  const int THREADS = 4;
+
+  mt19937_64 rng (17);
+  lognormal_distribution<double> latency (11, 1.2);    // median ~60 us
+  vector<int64_t> values (n);
+  for (long i = 0; i < n; i++) values[i] = (int64_t) latency (rng);
+
+  // one value at a time, then in a batch
+  QuantileSketch single;
+  auto start = chrono::steady_clock::now ();
+  for (long i = 0; i < n; i++) single.add (values[i]);
+  double tSingle = seconds (start);
+
+  QuantileSketch batch;
+  start = chrono::steady_clock::now ();
+  batch.add (values.data(), n);
+  double tBatch = seconds (start);
+
+  // a sketch per thread, merged at the end
+  vector<QuantileSketch> parts (THREADS);
+  vector<thread> threads;
+  start = chrono::steady_clock::now ();
+  for (int t = 0; t < THREADS; t++) {
+    threads.push_back (thread ([&, t] () {
+      long first = n * t / THREADS, last = n * (t + 1) / THREADS;
+      parts[t].add (values.data() + first, last - first);
+    }));
+  }
+  for (int t = 0; t < THREADS; t++) threads[t].join ();
+  QuantileSketch merged;
+  bool mergeOk = true;
+  for (int t = 0; t < THREADS; t++) mergeOk &= merged.merge (parts[t]);
+  double tThreads = seconds (start);
+
+  // and through a stream, as another process would send it
+  stringstream pipe;
+  merged.write (pipe);
+  size_t wireBytes = pipe.str().size();
+  QuantileSketch received;
+  bool readOk = received.read (pipe);
+
+  start = chrono::steady_clock::now ();
+  vector<int64_t> sorted (values);
+  sort (sorted.begin(), sorted.end());
+  double tSort = seconds (start);
+
+  printf ("%ld values\n\n", n);
+  printf ("memory\t\tsketch %zu bytes (%zu on the wire)\tsort %zu bytes\n",
+          merged.bytes (), wireBytes, n * sizeof (int64_t));
+  printf ("values/s\tone at a time %.3g\tbatch %.3g\t%d threads %.3g"
+          "\tsort %.3g\n", n / tSingle, n / tBatch, THREADS, n / tThreads,
+          n / tSort);
+
+  bool same = mergeOk && readOk && received.counts == single.counts &&
+              batch.counts == single.counts && merged.counts == single.counts;
+  printf ("single, batch, merged and received sketches agree: %s\n\n",
+          same ? "yes" : "NO");
+
+  double bound = pow (2.0, -merged.precision);
+  printf ("quantile\texact\t\tsketch\t\terror\t(bound %.2f%%)\n",
+          100 * bound);
+  double qs[] = { 0.5, 0.9, 0.99, 0.999, 0.9999 };
+  bool within = true;
+  for (double q : qs) {
+    long rank = (long) ceil (q * n);
+    int64_t exact = sorted[rank - 1];
+    int64_t approx = received.quantile (q);
+    double error = fabs ((double) approx - exact) / exact;
+    if (error > bound) within = false;
+    printf ("p%g\t\t%lld\t\t%lld\t\t%.3f%%\n", q * 100, (long long) exact,
+            (long long) approx, 100 * error);
+  }
+  printf ("all within bound: %s\n", within ? "yes" : "NO");
+  return 0;
+}
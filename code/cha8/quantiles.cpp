@@ -0,0 +1,18 @@
+#include <iostream>
+#include "Quantile.h"
+using namespace std;
+
+// push_back.cpp without the vector: the numbers go into a sketch as
+// they arrive, so memory stays the same however many there are.
+int main() {
+   QuantileSketch sketch;
+   long long c;
+   cout<<"Enter as many numbers as you like (-1 to stop): ";
+   while(cin >> c && c != -1) {
+       sketch.add(c);
+   }
+   cout << sketch.total << " numbers, mean " << sketch.mean() << endl;
+   cout << "p50   " << sketch.quantile(0.5) << endl;
+   cout << "p99   " << sketch.quantile(0.99) << endl;
+   cout << "p99.9 " << sketch.quantile(0.999) << endl;
+}
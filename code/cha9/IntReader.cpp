@@ -0,0 +1,113 @@
+#include <climits>
+#include <stdint.h>
+#include <cstring>
+#include "IntReader.h"
+
+IntReader::IntReader (FILE* f, size_t bufferSize)
+  : file (f), buffer (bufferSize < 64 ? 64 : bufferSize)
+{
+  pos = 0;
+  end = 0;
+  atEof = false;
+  failed = false;
+}
+
+// Moves what is left to the front of the buffer and fills the rest.
+// Returns false if nothing more could be read.
+bool IntReader::refill ()
+{
+  if (atEof) return false;
+  size_t left = end - pos;
+  memmove (buffer.data(), buffer.data() + pos, left);
+  pos = 0;
+  end = left;
+  if (end == buffer.size()) buffer.resize (2 * buffer.size());  // huge token
+  size_t got = fread (buffer.data() + end, 1, buffer.size() - end, file);
+  end += got;
+  if (got == 0) atEof = true;
+  return got > 0;
+}
+
+static inline bool isSpace (char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+// Parses one int starting at pos.  The token has to run into
+// whitespace or the end of the input; if it runs into the end of the
+// buffer instead, the buffer is refilled and the token parsed again.
+bool IntReader::parse (int& value)
+{
+  for (;;) {
+    while (pos < end && isSpace (buffer[pos])) pos++;
+    if (pos < end) break;
+    if (!refill ()) return false;
+  }
+
+  // with a full int's worth of bytes in the buffer, the digit loop
+  // needs no end checks; tokens it can't finish go the long way
+  if (end - pos > 12) {
+    const char* p = buffer.data() + pos;
+    bool negative = (*p == '-');
+    p += (*p == '-' || *p == '+');
+    const char* digits = p;
+    uint64_t v = 0;
+    unsigned d;
+    while ((d = (unsigned) (*p - '0')) < 10 && p - digits < 10) {
+      v = v * 10 + d;
+      p++;
+    }
+    uint64_t limit = negative ? (uint64_t) INT_MAX + 1 : INT_MAX;
+    if (p > digits && isSpace (*p) && v <= limit) {
+      value = (int) (negative ? -(int64_t) v : (int64_t) v);
+      pos = p - buffer.data();
+      return true;
+    }
+  }
+
+  for (;;) {
+    const char* p = buffer.data() + pos;
+    const char* stop = buffer.data() + end;
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+      negative = (*p == '-');
+      p++;
+    }
+    const char* digits = p;
+    while (p < stop && *p == '0') p++;
+    const char* significant = p;
+    uint64_t v = 0;
+    while (p < stop && (unsigned) (*p - '0') < 10) {
+      v = v * 10 + (*p - '0');
+      p++;
+      if (p - significant > 10) break;    // too long for an int anyway
+    }
+
+    if (p == stop && !atEof) {
+      // the token may go on past what has been read so far; refill
+      // moves the bytes, so start the token again either way
+      refill ();
+      continue;
+    }
+    if (p == digits || p - significant > 10 || (p < stop && !isSpace (*p))) {
+      failed = true;
+      return false;
+    }
+    uint64_t limit = negative ? (uint64_t) INT_MAX + 1 : INT_MAX;
+    if (v > limit) {
+      failed = true;
+      return false;
+    }
+    value = (int) (negative ? -(int64_t) v : (int64_t) v);
+    pos = p - buffer.data();
+    return true;
+  }
+}
+
+long IntReader::read (int* out, long max)
+{
+  long count = 0;
+  while (count < max && !failed && parse (out[count])) count++;
+  return count;
+}
@@ -0,0 +1,34 @@
+#ifndef INTREADER_H
+#define INTREADER_H
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+// Reads whitespace-separated ints from a file (stdin by default) much
+// faster than cin >> x.  It pulls the input in large blocks with fread
+// and parses the digits itself, without locale or stream state.  Like
+// cin, it stops at the first thing that is not an int ("12abc", "x",
+// or a number too big for an int); good () then returns false, the way
+// cin.good () does in enter_int.cpp.
+class IntReader
+{
+  FILE* file;
+  vector<char> buffer;
+  size_t pos, end;       // the unread bytes are buffer[pos..end)
+  bool atEof, failed;
+
+  bool refill ();
+  bool parse (int& value);
+
+public:
+  IntReader (FILE* file = stdin, size_t bufferSize = 1 << 20);
+
+  // Reads up to max ints into out and returns how many it read.  Fewer
+  // than max means the input ran out or held something invalid.
+  long read (int* out, long max);
+  bool read (int& value) { return read (&value, 1) == 1; }
+
+  bool good () const { return !failed; }
+  bool eof () const { return atEof && pos == end; }
+};
+#endif
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+using namespace std;
+#include "IntReader.h"
+
+// Writes n random ints (20 million by default) to a file, then runs
+// this program again on it once for each way of reading stdin:
+//   int_bench cin|nosync|reader < file
+// and compares ints per second.  Before that it checks IntReader on
+// tricky input, including with a tiny buffer so tokens are split.
+
+double seconds (chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+// reads all of stdin one way and prints "count sum seconds"
+int readAll (const char* mode)
+{
+  long count = 0, sum = 0;
+  auto start = chrono::steady_clock::now ();
+  if (strcmp (mode, "reader") == 0) {
+    IntReader reader;
+    int batch[4096];
+    long got;
+    while ((got = reader.read (batch, 4096)) > 0) {
+      for (long i = 0; i < got; i++) sum += batch[i];
+      count += got;
+    }
+    if (!reader.good ()) return 1;
+  } else {
+    if (strcmp (mode, "nosync") == 0) ios::sync_with_stdio (false);
+    int x;
+    while (cin >> x) {
+      sum += x;
+      count++;
+    }
+  }
+  printf ("%ld %ld %f\n", count, sum, seconds (start));
+  return 0;
+}
+
+// what read should return for text, given as "count values..." and
+// whether the reader should still be good
+bool expect (const char* text, size_t bufferSize, long count,
+             const int* values, bool good)
+{
+  FILE* f = fmemopen ((void*) text, strlen (text), "r");
+  IntReader reader (f, bufferSize);
+  int out[16];
+  long got = reader.read (out, 16);
+  fclose (f);
+  if (got != count || reader.good () != good) return false;
+  for (long i = 0; i < got; i++) {
+    if (out[i] != values[i]) return false;
+  }
+  return true;
+}
+
+bool check ()
+{
+  const int a[] = { 12, -7, 3, 2147483647, -2147483648, 5 };
+  const int b[] = { 12 };
+  bool ok = true;
+  for (size_t size : { 64, 1 << 16 }) {
+    ok = ok && expect ("12 -7 +3 2147483647\n-2147483648\t\t0005\n", size,
+                       6, a, true);
+    ok = ok && expect ("12 x 5", size, 1, b, false);
+    ok = ok && expect ("12 12abc", size, 1, b, false);
+    ok = ok && expect ("12 2147483648", size, 1, b, false);
+    ok = ok && expect ("12 -2147483649", size, 1, b, false);
+    ok = ok && expect ("12 - 5", size, 1, b, false);
+    ok = ok && expect ("   \n", size, 0, b, true);
+  }
+  // a token split over many refills
+  string zeros = "   " + string (200, '0') + "12";
+  ok = ok && expect (zeros.c_str(), 64, 1, b, true);
+  return ok;
+}
+
+int main (int argc, char* argv[])
+{
+  if (argc > 1 && !isdigit (argv[1][0])) return readAll (argv[1]);
+
+  long n = 20000000;
+  if (argc > 1) n = atol (argv[1]);
+  cout << "reader handles bad and split input: " << (check () ? "yes" : "NO")
+       << endl;
+
+  const char* path = "int_bench.txt";
+  FILE* out = fopen (path, "w");
+  mt19937 rng (17);
+  for (long i = 0; i < n; i++) {
+    fprintf (out, "%d%c", (int) rng () - (1 << 30) / (int) (1 + rng () % 1000),
+             i % 10 == 9 ? '\n' : ' ');
+  }
+  fclose (out);
+
+  cout << n << " ints" << endl;
+  const char* modes[] = { "cin", "nosync", "reader" };
+  const char* names[] = { "cin >>", "cin >>, no sync", "IntReader" };
+  double base = 0;
+  long firstSum = 0;
+  for (int m = 0; m < 3; m++) {
+    string command = string (argv[0]) + " " + modes[m] + " < " + path;
+    FILE* run = popen (command.c_str(), "r");
+    long count = 0, sum = 0;
+    double t = 0;
+    bool ok = fscanf (run, "%ld %ld %lf", &count, &sum, &t) == 3;
+    pclose (run);
+    if (m == 0) {
+      base = t;
+      firstSum = sum;
+    }
+    ok = ok && count == n && sum == firstSum;
+    printf ("%-16s%.3g ints/s\t(%.1fx)%s\n", names[m], n / t, base / t,
+            ok ? "" : "\tWRONG");
+  }
+  remove (path);
+  return 0;
+}